@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstdint>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/Buffer.h"
+#include "velocypack/Builder.h"
+#include "velocypack/Options.h"
+#include "velocypack/Sink.h"
+#include "velocypack/Slice.h"
+
+namespace arangodb::velocypack {
+
+class ArrayStreamer {
+  // Writes a top-level compact Array (0x13) to a SeekableSink member by
+  // member, so that only the member being built needs to be kept in
+  // memory. Members are built in builder() and written by next(), or
+  // written with add().
+  //
+  // The byte length in the header of a compact Array is a variable length
+  // integer, whose width is only known when the last member is written.
+  // Therefore 9 bytes are reserved for the header up front, and finish()
+  // writes the header into their end, in front of the first member.
+  // For a Sink that cannot be written to twice, see ArrayBatchStreamer.
+ public:
+  ArrayStreamer(ArrayStreamer const&) = delete;
+  ArrayStreamer& operator=(ArrayStreamer const&) = delete;
+
+  // Writes one Array to sink, starting at its current position. The
+  // Array does not necessarily start there: it is preceded by up to 8
+  // zero bytes, which are not part of it. finish() returns the number of
+  // these bytes.
+  explicit ArrayStreamer(SeekableSink& sink,
+                         Options const* options = &Options::Defaults);
+
+  // the Builder for the next member
+  Builder& builder() noexcept { return _builder; }
+
+  // writes the member in builder(), which must be closed, and clears
+  // builder()
+  void next();
+
+  // writes a complete member
+  void add(Slice member);
+
+  // number of members written
+  ValueLength length() const noexcept { return _length; }
+
+  // Writes the end of the Array and its header. Returns the offset of the
+  // Array from the position of the sink when the ArrayStreamer was
+  // created, i.e. the number of zero bytes in front of it (0 to 8).
+  ValueLength finish();
+
+ private:
+  Builder _builder;
+  SeekableSink& _sink;
+  // position of the reserved header
+  ValueLength _start;
+  // byte size of the members written
+  ValueLength _membersSize;
+  ValueLength _length;
+  bool _finished;
+};
+
+class ArrayBatchStreamer {
+  // Writes members to a Sink as a sequence of compact Arrays (0x13), for
+  // Sinks that cannot be written to twice, e.g. pipes and sockets. The
+  // members are collected until they take flushSize bytes, and are then
+  // written as one complete Array. The output is therefore not one
+  // VelocyPack value, but a sequence of Arrays that must be read until the
+  // end of the input. Their members, in order, are the members added.
+  // Without any members, one empty Array is written.
+ public:
+  static constexpr ValueLength defaultFlushSize = 64 * 1024;
+
+  ArrayBatchStreamer(ArrayBatchStreamer const&) = delete;
+  ArrayBatchStreamer& operator=(ArrayBatchStreamer const&) = delete;
+
+  explicit ArrayBatchStreamer(Sink& sink,
+                              ValueLength flushSize = defaultFlushSize,
+                              Options const* options = &Options::Defaults);
+
+  // the Builder for the next member
+  Builder& builder() noexcept { return _builder; }
+
+  // adds the member in builder(), which must be closed, and clears
+  // builder()
+  void next();
+
+  // adds a complete member
+  void add(Slice member);
+
+  // number of members added
+  ValueLength length() const noexcept { return _length; }
+
+  // number of Arrays written
+  ValueLength numArrays() const noexcept { return _numArrays; }
+
+  // writes the members not yet written
+  void finish();
+
+ private:
+  void write(uint8_t const* data, ValueLength size);
+  void flush();
+
+  Builder _builder;
+  Sink& _sink;
+  // members not yet written
+  Buffer<uint8_t> _pending;
+  ValueLength const _flushSize;
+  // members added in total and in _pending
+  ValueLength _length;
+  ValueLength _pendingLength;
+  ValueLength _numArrays;
+  bool _finished;
+};
+
+}  // namespace arangodb::velocypack
+
+using VPackArrayStreamer = arangodb::velocypack::ArrayStreamer;
+using VPackArrayBatchStreamer = arangodb::velocypack::ArrayBatchStreamer;
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "velocypack/velocypack-common.h"
+
+namespace arangodb::velocypack {
+
+class AttributeProjection {
+  // A set of attribute paths for the Parser (see Options::projection).
+  // Each node of the tree is an attribute name, a node without children
+  // selects the whole value of its attribute.
+ public:
+  AttributeProjection(AttributeProjection const&) = delete;
+  AttributeProjection& operator=(AttributeProjection const&) = delete;
+
+  AttributeProjection() = default;
+  ~AttributeProjection() = default;
+
+  // selects the value at the given path of attribute names, including
+  // all of its subvalues. an empty path selects everything
+  void add(std::vector<std::string_view> const& path);
+
+  void add(std::initializer_list<std::string_view> path) {
+    add(std::vector<std::string_view>(path));
+  }
+
+  // returns the subtree for the attribute name, or nullptr if the
+  // attribute is not selected
+  AttributeProjection const* get(std::string_view name) const noexcept {
+    // there are usually only a few attributes per level, so a linear
+    // search is faster than any hashing
+    for (auto const& it : _children) {
+      if (it.first == name) {
+        return it.second.get();
+      }
+    }
+    return nullptr;
+  }
+
+  // whether the whole value is selected
+  bool selectsAll() const noexcept { return _all; }
+
+  void clear() noexcept {
+    _children.clear();
+    _all = false;
+  }
+
+ private:
+  std::vector<std::pair<std::string, std::unique_ptr<AttributeProjection>>>
+      _children;
+  bool _all = false;
+};
+
+}  // namespace arangodb::velocypack
+
+using VPackAttributeProjection = arangodb::velocypack::AttributeProjection;
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/Builder.h"
+#include "velocypack/Options.h"
+#include "velocypack/SharedSlice.h"
+#include "velocypack/Slice.h"
+
+namespace arangodb::velocypack {
+
+class BatchBuilder {
+  // Produces many small documents and stores them back to back in large,
+  // reference-counted chunks of memory. The SharedSlices handed out share
+  // the ownership of their chunk, so a chunk is freed when the last of its
+  // documents is released. This takes one allocation per chunk, instead of
+  // one Buffer and one control block per document, and keeps documents
+  // produced one after the other close together in memory.
+  // Documents are built in builder(), which keeps its memory from one
+  // document to the next, and are copied into the current chunk by
+  // finish(). A chunk never grows, as that would move the documents in it.
+  // A document larger than a quarter of the chunk size gets a chunk of
+  // its own.
+ public:
+  static constexpr ValueLength defaultChunkSize = 64 * 1024;
+
+  BatchBuilder(BatchBuilder const&) = delete;
+  BatchBuilder& operator=(BatchBuilder const&) = delete;
+
+  explicit BatchBuilder(Options const* options = &Options::Defaults,
+                        ValueLength chunkSize = defaultChunkSize);
+
+  // the Builder for the next document
+  Builder& builder() noexcept { return _builder; }
+
+  // Copies the document in builder() into the current chunk, clears
+  // builder() and returns the document. builder() must be closed. Returns
+  // a None SharedSlice if builder() is empty.
+  [[nodiscard]] SharedSlice finish();
+
+  // Copies a complete document into the current chunk and returns it
+  [[nodiscard]] SharedSlice add(Slice document);
+
+  // number of chunks allocated so far
+  std::size_t numChunks() const noexcept { return _numChunks; }
+
+  ValueLength chunkSize() const noexcept { return _chunkSize; }
+
+ private:
+  // returns room for size bytes, owned by the returned pointer
+  std::shared_ptr<uint8_t> allocate(ValueLength size);
+
+  Builder _builder;
+  // the chunk documents are currently appended to
+  std::shared_ptr<uint8_t[]> _chunk;
+  ValueLength const _chunkSize;
+  ValueLength _used;
+  std::size_t _numChunks;
+};
+
+}  // namespace arangodb::velocypack
+
+using VPackBatchBuilder = arangodb::velocypack::BatchBuilder;
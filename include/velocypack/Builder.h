@@ -28,6 +28,7 @@
 #include <cstring>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -39,10 +40,12 @@
 #include "velocypack/Buffer.h"
 #include "velocypack/Exception.h"
 #include "velocypack/Options.h"
+#include "velocypack/PreparedKey.h"
 #include "velocypack/Serializable.h"
 #include "velocypack/SharedSlice.h"
 #include "velocypack/Slice.h"
 #include "velocypack/SmallVector.h"
+#include "velocypack/SplicedArray.h"
 #include "velocypack/Value.h"
 #include "velocypack/ValueType.h"
 
@@ -52,6 +55,8 @@ class ObjectIterator;
 
 class Builder {
   friend class Parser;  // The parser needs access to internals.
+  friend class IncrementalParser;
+  friend class TapeBuilder;
 
   // Here are the mechanics of how this building process works:
   // The whole VPack being built starts at where _start points to.
@@ -88,6 +93,8 @@ class Builder {
   struct CompoundInfo {
     ValueLength startPos;
     ValueLength indexStartPos;
+    // opened with Options::AccessHint::Random, keep the index table
+    bool randomAccess;
   };
 
   static constexpr std::size_t arenaSize = 64;
@@ -104,6 +111,21 @@ class Builder {
   // not yet
   bool _keyWritten;
 
+  // Hash index of the attribute names in the innermost open Object, built
+  // by getKey() once the Object has more than a few members. Each lookup
+  // adds the members added since the previous one. The index is dropped
+  // when the Object is closed, but its memory is kept for the next one.
+  struct KeyIndex {
+    // hash of the attribute name, and offset of the attribute name in
+    // the Object plus 1. 0 marks an empty slot
+    std::vector<std::pair<uint64_t, ValueLength>> slots;
+    // stack depth of the indexed Object, 0 if no Object is indexed
+    std::size_t depth = 0;
+    // number of members in the index
+    std::size_t members = 0;
+  };
+  mutable KeyIndex _keyIndex;
+
  public:
   Options const* options;
 
@@ -212,6 +234,7 @@ class Builder {
       _start = _bufferPtr->data();
     }
     _keyWritten = false;
+    _keyIndex.depth = 0;
   }
 
   // Return a pointer to the start of the result:
@@ -300,6 +323,18 @@ class Builder {
     openCompoundValue(unindexed ? 0x14 : 0x0b);
   }
 
+  // Open an Array or Object whose format follows the access hint, see
+  // Options::selectCompactFormat:
+  inline void openArray(Options::AccessHint hint) {
+    openCompoundValue(hint == Options::AccessHint::Sequential ? 0x13 : 0x06,
+                      hint == Options::AccessHint::Random);
+  }
+
+  inline void openObject(Options::AccessHint hint) {
+    openCompoundValue(hint == Options::AccessHint::Sequential ? 0x14 : 0x0b,
+                      hint == Options::AccessHint::Random);
+  }
+
   template<typename T>
   uint8_t* addUnchecked(Slice key, T const& sub) {
     bool needCleanup = !_stack.empty();
@@ -355,6 +390,37 @@ class Builder {
     }
   }
 
+  // Add a subvalue into an object from a Value, with a prepared
+  // attribute name. The key must have been prepared with the attribute
+  // translator of this Builder's Options, otherwise an exception is thrown:
+  inline uint8_t* add(PreparedKey const& key, Value const& sub) {
+    return addInternal<Value>(key, sub);
+  }
+
+  // Add a subvalue into an object from a Slice, with a prepared
+  // attribute name:
+  inline uint8_t* add(PreparedKey const& key, Slice const& sub) {
+    return addInternal<Slice>(key, sub);
+  }
+
+  // Add a subvalue into an object from a ValuePair, with a prepared
+  // attribute name:
+  inline uint8_t* add(PreparedKey const& key, ValuePair const& sub) {
+    return addInternal<ValuePair>(key, sub);
+  }
+
+  // Add a subvalue into an object from a Serialize, with a prepared
+  // attribute name:
+  inline uint8_t* add(PreparedKey const& key, Serialize const& sub) {
+    return addInternal<Serializable>(key, sub._sable);
+  }
+
+  // Add an Array whose members are copied from other buffers into an
+  // object, with a prepared attribute name:
+  inline uint8_t* add(PreparedKey const& key, SplicedArray const& sub) {
+    return addInternal<SplicedArray>(key, sub);
+  }
+
   // Add a subvalue into an object from a Value:
   inline uint8_t* add(std::string_view attrName, Value const& sub) {
     return addInternal<Value>(attrName, sub);
@@ -404,6 +470,12 @@ class Builder {
     return addInternal<Serializable>(attrName, sub._sable);
   }
 
+  // Add an Array whose members are copied from other buffers into an
+  // object:
+  inline uint8_t* add(std::string_view attrName, SplicedArray const& sub) {
+    return addInternal<SplicedArray>(attrName, sub);
+  }
+
   inline uint8_t* add(char const* attrName, std::size_t attrLength,
                       Serialize const& sub) {
     return addInternal<Serializable>(std::string_view(attrName, attrLength),
@@ -436,6 +508,12 @@ class Builder {
     return addInternal<Serializable>(sub._sable);
   }
 
+  // Add an Array whose members are copied from other buffers. Its byte
+  // size is known up front, so the Builder grows at most once:
+  inline uint8_t* add(SplicedArray const& sub) {
+    return addInternal<SplicedArray>(sub);
+  }
+
   // Add a subvalue into an object from a Value:
   inline uint8_t* addTagged(std::string_view attrName, uint64_t tag,
                             Value const& sub) {
@@ -551,6 +629,21 @@ class Builder {
   uint8_t* add(ArrayIterator&& sub);
   uint8_t* add(ArrayIterator& sub) { return add(std::move(sub)); }
 
+  // Add an array with all values. This builds the same array as adding
+  // the values one by one, but without the bookkeeping for each of them
+  uint8_t* addArray(std::span<int64_t const> values);
+  uint8_t* addArray(std::span<uint64_t const> values);
+  uint8_t* addArray(std::span<double const> values);
+
+  // Add an object with one attribute per column, whose value is an array
+  // with all values of the column as built by addArray()
+  uint8_t* addObject(std::span<std::string_view const> names,
+                     std::span<std::span<int64_t const> const> columns);
+  uint8_t* addObject(std::span<std::string_view const> names,
+                     std::span<std::span<uint64_t const> const> columns);
+  uint8_t* addObject(std::span<std::string_view const> names,
+                     std::span<std::span<double const> const> columns);
+
   // Seal the innermost array or object:
   Builder& close();
 
@@ -630,6 +723,11 @@ class Builder {
  private:
   void closeLevel() noexcept;
 
+  // looks up key in the open Object at pos, whose first n members are
+  // complete, using the key index
+  Slice getKeyIndexed(std::string_view key, ValueLength pos,
+                      std::size_t n) const;
+
   void sortObjectIndexShort(uint8_t* objBase,
                             std::vector<ValueLength>::iterator indexStart,
                             std::vector<ValueLength>::iterator indexEnd) const;
@@ -653,6 +751,12 @@ class Builder {
   // close for the empty case:
   Builder& closeEmptyArrayOrObject(ValueLength pos, bool isArray);
 
+  // whether Options::selectCompactFormat builds the open Array or Object
+  // without index table
+  bool selectsCompactFormat(ValueLength pos, bool isArray,
+                            std::vector<ValueLength>::iterator indexStart,
+                            std::vector<ValueLength>::iterator indexEnd) const;
+
   // close for the compact case:
   bool closeCompactArrayOrObject(ValueLength pos, bool isArray,
                                  std::vector<ValueLength>::iterator indexStart,
@@ -782,6 +886,18 @@ class Builder {
     addCompoundValue(unindexed ? 0x13 : 0x06);
   }
 
+  template<typename T>
+  uint8_t* addArrayOf(std::span<T const> values);
+
+  template<typename T>
+  uint8_t* addObjectOf(std::span<std::string_view const> names,
+                       std::span<std::span<T const> const> columns);
+
+  // writes all values into the just opened array and closes it. the
+  // space for the values must have been reserved
+  template<typename T>
+  void fillArray(std::span<T const> values);
+
   inline void addObject(bool unindexed = false) {
     addCompoundValue(unindexed ? 0x14 : 0x0b);
   }
@@ -873,6 +989,40 @@ class Builder {
     }
   }
 
+  template<typename T>
+  uint8_t* addInternal(PreparedKey const& key, T const& sub) {
+    if (VELOCYPACK_UNLIKELY(key.translator() != options->attributeTranslator)) {
+      throw Exception(Exception::BuilderUnexpectedValue,
+                      "PreparedKey was prepared with a different attribute "
+                      "translator");
+    }
+    bool haveReported = false;
+    if (!_stack.empty()) {
+      ValueLength const to = _stack.back().startPos;
+      if (VELOCYPACK_UNLIKELY(_start[to] != 0x0b && _start[to] != 0x14)) {
+        throw Exception(Exception::BuilderNeedOpenObject);
+      }
+      if (VELOCYPACK_UNLIKELY(_keyWritten)) {
+        throw Exception(Exception::BuilderKeyAlreadyWritten);
+      }
+      reportAdd();
+      haveReported = true;
+    }
+
+    try {
+      reserve(key.size());
+      memcpy(_start + _pos, key.data(), key.size());
+      advance(key.size());
+      return writeValue(sub);
+    } catch (...) {
+      // clean up in case of an exception
+      if (haveReported) {
+        cleanupAdd();
+      }
+      throw;
+    }
+  }
+
   template<typename T>
   uint8_t* addInternalTagged(std::string_view attrName, uint64_t tag,
                              T const& sub) {
@@ -932,21 +1082,21 @@ class Builder {
     return set(sub);
   }
 
-  void addCompoundValue(uint8_t type) {
+  void addCompoundValue(uint8_t type, bool randomAccess = false) {
     reserve(9);
     // an Array or Object is started:
-    _stack.push_back(CompoundInfo{_pos, _indexes.size()});
+    _stack.push_back(CompoundInfo{_pos, _indexes.size(), randomAccess});
     appendByteUnchecked(type);
     std::memset(_start + _pos, 0, 8);
     advance(8);  // Will be filled later with bytelength and nr subs
   }
 
-  void openCompoundValue(uint8_t type) {
+  void openCompoundValue(uint8_t type, bool randomAccess = false) {
     if (_stack.empty()) {
-      addCompoundValue(type);
+      addCompoundValue(type, randomAccess);
     } else if (_keyWritten) {
       _keyWritten = false;
-      addCompoundValue(type);
+      addCompoundValue(type, randomAccess);
     } else {
       ValueLength const to = _stack.back().startPos;
       if (VELOCYPACK_UNLIKELY(_start[to] != 0x06 && _start[to] != 0x13)) {
@@ -954,7 +1104,7 @@ class Builder {
       }
       reportAdd();
       try {
-        addCompoundValue(type);
+        addCompoundValue(type, randomAccess);
       } catch (...) {
         cleanupAdd();
         throw;
@@ -970,6 +1120,8 @@ class Builder {
 
   uint8_t* set(Slice const& item);
 
+  uint8_t* set(SplicedArray const& item);
+
   uint8_t* set(Serializable const& sable) {
     auto const oldPos = _pos;
 
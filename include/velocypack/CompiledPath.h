@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/Slice.h"
+
+namespace arangodb::velocypack {
+
+class CompiledPath {
+  // An attribute path that is looked up in many Objects of the same
+  // shape. For every step of the path, it remembers the position in the
+  // index table of the Object where the attribute was found last time.
+  // The next lookup compares the key at that position first, and only
+  // searches the Object if the key differs. Compact Objects have no index
+  // table and are always searched. A CompiledPath is modified by lookups,
+  // so each thread needs its own (copy).
+ public:
+  explicit CompiledPath(std::vector<std::string_view> const& path);
+  CompiledPath(std::initializer_list<std::string_view> path)
+      : CompiledPath(std::vector<std::string_view>(path)) {}
+
+  // look for the attribute path inside an Object, like Slice::get()
+  // returns a Slice(ValueType::None) if not found
+  Slice get(Slice slice, bool resolveExternals = false);
+
+  // number of steps found at the remembered position, and number of
+  // steps that needed a search
+  uint64_t hits() const noexcept { return _hits; }
+  uint64_t misses() const noexcept { return _misses; }
+
+ private:
+  struct Step {
+    std::string name;
+    // position in the index table where name was found last time
+    ValueLength index;
+  };
+
+  Slice lookup(Step& step, Slice object);
+
+  std::vector<Step> _steps;
+  uint64_t _hits;
+  uint64_t _misses;
+};
+
+}  // namespace arangodb::velocypack
+
+using VPackCompiledPath = arangodb::velocypack::CompiledPath;
@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/Builder.h"
+#include "velocypack/Options.h"
+#include "velocypack/Parser.h"
+
+namespace arangodb::velocypack {
+
+class IncrementalParser {
+  // This class parses a single JSON value that is handed in as a
+  // sequence of chunks of arbitrary sizes, e.g. as they arrive from the
+  // network. The result is built in the Builder while the input is
+  // coming in. Only a value that is split across two or more chunks
+  // (a string, a number or a literal) is buffered until it is complete,
+  // so the input never needs to be kept in memory as a whole.
+  // After an exception, the parser must be reset() before it can be
+  // used again.
+
+  enum class State : uint8_t {
+    Value,        // expecting a value
+    ArrayFirst,   // expecting the first array member or ']'
+    ArrayNext,    // expecting ',' or ']'
+    ObjectFirst,  // expecting the first attribute name or '}'
+    ObjectKey,    // expecting an attribute name
+    ObjectColon,  // expecting ':'
+    ObjectNext,   // expecting ',' or '}'
+    Done          // top-level value is complete
+  };
+
+  // a value that started in a previous chunk and is not complete yet
+  enum class Pending : uint8_t { None, String, Key, Scalar };
+
+  Parser _parser;
+  // true for each open object, false for each open array
+  std::vector<bool> _stack;
+  // bytes of the pending value seen so far
+  std::string _pending;
+  // number of bytes in all previous chunks
+  std::size_t _offset;
+  // position of the last unescaped quote in the current chunk
+  std::size_t _lastQuote;
+  // position of the last error in the overall input
+  std::size_t _errorPos;
+  // builder position of the last attribute name
+  ValueLength _keyPos;
+  State _state;
+  Pending _pendingType;
+  // whether the next byte of the pending string is escaped
+  bool _escaped;
+  // whether the top-level value was reported to the Builder
+  bool _haveReported;
+  bool _started;
+
+ public:
+  Options const* options;
+
+  IncrementalParser(IncrementalParser const&) = delete;
+  IncrementalParser(IncrementalParser&&) = delete;
+  IncrementalParser& operator=(IncrementalParser const&) = delete;
+  IncrementalParser& operator=(IncrementalParser&&) = delete;
+  ~IncrementalParser() = default;
+
+  IncrementalParser() : IncrementalParser(&Options::Defaults) {}
+
+  explicit IncrementalParser(Options const* options)
+      : _parser(options), options(options) {
+    reset();
+  }
+
+  explicit IncrementalParser(std::shared_ptr<Builder> const& builder,
+                             Options const* options = &Options::Defaults)
+      : _parser(builder, options), options(options) {
+    reset();
+  }
+
+  // This constructor produces a parser that does not own the builder
+  explicit IncrementalParser(Builder& builder,
+                             Options const* options = &Options::Defaults)
+      : _parser(builder, options), options(options) {
+    reset();
+  }
+
+  Builder const& builder() const { return _parser.builder(); }
+
+  std::shared_ptr<Builder> steal() { return _parser.steal(); }
+
+  // Feeds the next chunk of input. Returns true if the top-level value
+  // is complete. A top-level number can only be recognized as complete
+  // when it is followed by whitespace, or when finish() is called.
+  bool feed(std::string_view chunk) {
+    return feed(reinterpret_cast<uint8_t const*>(chunk.data()), chunk.size());
+  }
+
+  bool feed(char const* start, std::size_t size) {
+    return feed(reinterpret_cast<uint8_t const*>(start), size);
+  }
+
+  bool feed(uint8_t const* start, std::size_t size);
+
+  // Signals the end of the input. Throws if the input did not contain
+  // a complete value.
+  void finish();
+
+  // Returns true if a complete top-level value has been parsed.
+  bool isComplete() const noexcept {
+    return _state == State::Done && _pendingType == Pending::None;
+  }
+
+  // Prepares the parser for a new value. The Builder is cleared before
+  // the first chunk of the new value if options->clearBuilderBeforeParse
+  // is set.
+  void reset() noexcept;
+
+  // Returns the position in the overall input at which the just
+  // reported error occurred, only use when handling an exception.
+  std::size_t errorPos() const noexcept { return _errorPos; }
+
+ private:
+  void start();
+
+  // handles the byte at data[pos] according to the current state
+  void handle(uint8_t const* data, std::size_t size, std::size_t& pos);
+
+  void beginValue(uint8_t const* data, std::size_t size, std::size_t& pos);
+
+  void endValue();
+
+  void closeCompound();
+
+  void scanString(uint8_t const* data, std::size_t size, std::size_t& pos,
+                  bool isKey);
+
+  void scanScalar(uint8_t const* data, std::size_t size, std::size_t& pos);
+
+  // continues the pending value with the next chunk
+  void resumePending(uint8_t const* data, std::size_t size, std::size_t& pos);
+
+  // parses a complete string starting behind its opening quote
+  void parseString(uint8_t const* data, std::size_t size, std::size_t pos,
+                   bool isKey);
+
+  // parses a complete scalar in data[pos, end) and returns the position
+  // behind the bytes that belong to it
+  std::size_t parseScalar(uint8_t const* data, std::size_t end,
+                          std::size_t pos);
+
+  void throwUnexpected() const;
+};
+
+}  // namespace arangodb::velocypack
+
+using VPackIncrementalParser = arangodb::velocypack::IncrementalParser;
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/HashedStringRef.h"
+#include "velocypack/SharedSlice.h"
+#include "velocypack/Slice.h"
+
+namespace arangodb::velocypack {
+
+class ObjectIndex {
+  // A hash table from the attribute names of an Object to their values,
+  // built once for Objects that are searched many times. The Object
+  // itself is not modified. A lookup hashes the name (or takes the hash
+  // from a HashedStringRef), and compares at most the names with the same
+  // hash and length. The ObjectIndex only stores offsets into the Object,
+  // which must stay valid while it is used. When built from a SharedSlice,
+  // the ObjectIndex keeps a reference to its buffer.
+ public:
+  // indexes the attributes of object, which must be an Object of less
+  // than 4GB. Of duplicate attribute names, the first one is found
+  explicit ObjectIndex(Slice object);
+  explicit ObjectIndex(SharedSlice object);
+
+  // the indexed Object
+  Slice slice() const noexcept { return _object; }
+
+  // number of attributes indexed
+  ValueLength size() const noexcept { return _size; }
+
+  // returns the value of the attribute, or a None Slice if there is none
+  Slice get(HashedStringRef attribute) const {
+    std::size_t const mask = _slots.size() - 1;
+    std::size_t i = attribute.hash() & mask;
+    while (true) {
+      Slot const& slot = _slots[i];
+      if (slot.valueOffset == 0) {
+        return Slice();
+      }
+      if (slot.tag == attribute.tag() &&
+          matches(slot, std::string_view(attribute.data(), attribute.size()))) {
+        return Slice(_object.start() + slot.valueOffset);
+      }
+      i = (i + 1) & mask;
+    }
+  }
+
+  Slice get(std::string_view attribute) const {
+    return get(HashedStringRef(attribute.data(),
+                               static_cast<uint32_t>(attribute.size())));
+  }
+
+  bool hasKey(HashedStringRef attribute) const {
+    return !get(attribute).isNone();
+  }
+
+  bool hasKey(std::string_view attribute) const {
+    return !get(attribute).isNone();
+  }
+
+ private:
+  struct Slot {
+    // hash and length of the attribute name, as in HashedStringRef::tag()
+    uint64_t tag;
+    // offsets of the key and of the value from the start of the Object.
+    // a valueOffset of 0 marks an empty slot
+    uint32_t keyOffset;
+    uint32_t valueOffset;
+  };
+
+  void build();
+
+  bool matches(Slot const& slot, std::string_view attribute) const {
+    return Slice(_object.start() + slot.keyOffset).makeKey().stringView() ==
+           attribute;
+  }
+
+  SharedSlice _owner;
+  Slice _object;
+  std::vector<Slot> _slots;
+  ValueLength _size;
+};
+
+}  // namespace arangodb::velocypack
+
+using VPackObjectIndex = arangodb::velocypack::ObjectIndex;
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/SharedSlice.h"
+#include "velocypack/Slice.h"
+
+namespace arangodb::velocypack {
+
+class OffsetCache {
+  // Random access to the members of a compact Array or Object (0x13 or
+  // 0x14), which otherwise walks over all members in front of the one
+  // accessed. The offsets of the members are remembered while they are
+  // walked, so that each member is walked at most once, and later accesses
+  // are O(1). get() sorts the keys of a compact Object once, and then uses
+  // a binary search. Other Arrays and Objects are accessed through their
+  // index tables as usual. The bytes of the Slice are not modified, and
+  // must stay valid while the OffsetCache is used. When built from a
+  // SharedSlice, the OffsetCache keeps a reference to its buffer. Accesses
+  // modify the OffsetCache, so each thread needs its own.
+ public:
+  explicit OffsetCache(Slice slice);
+  explicit OffsetCache(SharedSlice slice);
+
+  Slice slice() const noexcept { return _slice; }
+
+  // number of members
+  ValueLength length() const noexcept { return _length; }
+
+  // the member of an Array at the index, like Slice::at()
+  Slice at(ValueLength index);
+
+  Slice operator[](ValueLength index) { return at(index); }
+
+  // the key and the value of an Object at the index, like Slice::keyAt()
+  // and Slice::valueAt()
+  Slice keyAt(ValueLength index, bool translate = true);
+  Slice valueAt(ValueLength index);
+
+  // look for the specified attribute inside an Object, like Slice::get()
+  // returns a Slice(ValueType::None) if not found
+  Slice get(std::string_view attribute);
+
+ private:
+  void init();
+
+  // offset of the member (of its key in an Object) at the index
+  ValueLength offsetOf(ValueLength index);
+
+  SharedSlice _owner;
+  Slice _slice;
+  ValueLength _length;
+  bool _compact;
+  // offsets of the members walked so far
+  std::vector<ValueLength> _offsets;
+  // offset behind the last member walked
+  ValueLength _next;
+  // indexes of the members of a compact Object, in the order of their keys.
+  // empty until the first get()
+  std::vector<ValueLength> _sorted;
+};
+
+}  // namespace arangodb::velocypack
+
+using VPackOffsetCache = arangodb::velocypack::OffsetCache;
@@ -31,6 +31,7 @@
 #include "velocypack/velocypack-common.h"
 
 namespace arangodb::velocypack {
+class AttributeProjection;
 class AttributeTranslator;
 class Dumper;
 struct Options;
@@ -69,6 +70,18 @@ struct Options {
     Flexible
   };
 
+  // How the members of an Array or Object are going to be accessed. Used
+  // by the Builder as a hint when choosing the format of the value
+  enum class AccessHint {
+    // let the Builder decide
+    Unknown,
+    // members are only iterated over: build without index table
+    Sequential,
+    // members are looked up by position or attribute name: build with an
+    // index table whenever that is useful
+    Random
+  };
+
   Options() {}
 
   // Dumper behavior when a VPack value is serialized to JSON that
@@ -90,6 +103,23 @@ struct Options {
   // allow building Objects without index table?
   bool buildUnindexedObjects = false;
 
+  // let the Builder choose the format of each Array and Object when it is
+  // closed, instead of using buildUnindexedArrays and buildUnindexedObjects.
+  // small values are built without index table, as scanning their members
+  // is about as fast as a lookup in the index table. larger values, and
+  // Arrays whose members all have the same size, are built with random
+  // access. values opened as unindexed or with an AccessHint are built as
+  // requested
+  bool selectCompactFormat = false;
+
+  // with selectCompactFormat, Arrays and Objects with at most this many
+  // members are built without index table
+  ValueLength compactFormatMaxMembers = 8;
+
+  // with selectCompactFormat, Arrays and Objects whose members take at most
+  // this many bytes are built without index table
+  ValueLength compactFormatMaxByteSize = 64;
+
   // pretty-print JSON output when dumping with Dumper
   bool prettyPrint = false;
 
@@ -103,13 +133,39 @@ struct Options {
   // clear builder before starting to parse in Parser
   bool clearBuilderBeforeParse = true;
 
+  // make the Parser first build an index of all structural characters
+  // and string boundaries of the JSON input in a separate, vectorized
+  // pass, and then parse from this index. this mode is experimental and
+  // opt-in: it is not yet faster than the default parser, not even for
+  // inputs with lots of whitespace, and it needs up to 4 bytes of scratch
+  // memory per structural character of the input
+  bool useStructuralIndex = false;
+
+  // number of threads the Parser may use to parse the members of a large
+  // top-level array in parallel. 0 means one thread per hardware thread,
+  // 1 turns parallel parsing off
+  uint32_t parallelArrayThreads = 1;
+
+  // attribute paths the Parser should keep. if set, the Parser only builds
+  // the values at the ends of these paths, and skips everything else
+  // without building it. objects along a path keep only the attributes on
+  // a path, arrays along a path apply the projection to each of their
+  // members, and other values along a path are dropped. top-level scalars
+  // are kept. skipped values are only checked for balanced brackets and
+  // terminated strings
+  AttributeProjection const* projection = nullptr;
+
   // validate UTF-8 strings when JSON-parsing with Parser or validating with
   // Validator
   bool validateUtf8Strings = false;
 
   // validate that attribute names in Object values are actually
   // unique when creating objects via Builder. This also includes
-  // creation of Object values via a Parser
+  // creation of Object values via a Parser, and the Validator then
+  // rejects Objects with duplicate attribute names, too. The Validator
+  // has no attribute translator, so it compares integer (translated)
+  // attribute names only by value among each other, and never against
+  // string attribute names
   bool checkAttributeUniqueness = false;
 
   // escape forward slashes when serializing VPack values into
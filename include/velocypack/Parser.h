@@ -29,20 +29,31 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "velocypack/velocypack-common.h"
 #include "velocypack/Builder.h"
 #include "velocypack/Exception.h"
 #include "velocypack/Options.h"
+#include "velocypack/SharedSlice.h"
 
 namespace arangodb::velocypack {
+template<typename Handler>
+class SaxParser;
 
 class Parser {
   // This class can parse JSON very rapidly, but only from contiguous
   // blocks of memory. It builds the result using the Builder.
+  // IncrementalParser uses its internals to parse input in chunks, and
+  // SaxParser to scan strings and numbers.
+  friend class IncrementalParser;
+  template<typename Handler>
+  friend class SaxParser;
 
   struct ParsedNumber {
-    ParsedNumber() : intValue(0), doubleValue(0.0), isInteger(true) {}
+    ParsedNumber()
+        : intValue(0), exponent10(0), isInteger(true), isTruncated(false) {}
 
     void addDigit(int i) {
       if (isInteger) {
@@ -53,27 +64,54 @@ class Parser {
           intValue = intValue * 10 + (i - '0');
           return;
         }
-        // int would overflow
-        doubleValue = static_cast<double>(intValue);
+        // int would overflow. from now on we only keep the leading
+        // digits and count the remaining ones in the decimal exponent
         isInteger = false;
       }
 
-      doubleValue = doubleValue * 10.0 + (i - '0');
-      if (std::isnan(doubleValue) || !std::isfinite(doubleValue)) {
-        throw Exception(Exception::NumberOutOfRange);
+      ++exponent10;
+      if (i != '0') {
+        isTruncated = true;
       }
     }
 
-    double asDouble() const {
-      if (isInteger) {
-        return static_cast<double>(intValue);
+    void addFractionalDigit(int i) {
+      if (intValue < 1844674407370955161ULL) {
+        intValue = intValue * 10 + (i - '0');
+        --exponent10;
+      } else if (i != '0') {
+        // digit does not fit into the mantissa anymore
+        isTruncated = true;
       }
-      return doubleValue;
     }
 
+    // the value of the number is intValue * 10^exponent10, unless
+    // isTruncated is set. in this case intValue only contains the
+    // leading digits of the number
     uint64_t intValue;
-    double doubleValue;
+    int64_t exponent10;
     bool isInteger;
+    bool isTruncated;
+  };
+
+  // the attribute names of the last object that was a member of an array
+  // at a certain nesting depth, used to predict the names of the next
+  // such object
+  struct KeyShape {
+    // JSON of all attribute names, each without its opening but with its
+    // closing quote
+    std::string json;
+    // VPack of all attribute names, after translation
+    std::string vpack;
+    // end offsets of each attribute name in json and vpack
+    std::vector<std::pair<std::size_t, std::size_t>> ends;
+
+    // keeps only the first n attribute names
+    void truncate(std::size_t n) noexcept {
+      ends.resize(n);
+      json.resize(n == 0 ? 0 : ends.back().first);
+      vpack.resize(n == 0 ? 0 : ends.back().second);
+    }
   };
 
   std::shared_ptr<Builder> _builder;
@@ -82,6 +120,13 @@ class Parser {
   std::size_t _size;
   std::size_t _pos;
   uint32_t _nesting;
+  // positions of all structural characters, string delimiters and
+  // scalar value starts in the input, if options->useStructuralIndex
+  // is set. _structuralPos is the next position to be processed
+  std::vector<uint32_t> _structurals;
+  std::size_t _structuralPos;
+  // key shapes by nesting depth of the array
+  std::vector<std::unique_ptr<KeyShape>> _keyShapes;
 
  public:
   Options const* options;
@@ -97,6 +142,7 @@ class Parser {
         _size(0),
         _pos(0),
         _nesting(0),
+        _structuralPos(0),
         options(&Options::Defaults) {
     _builder = std::make_shared<Builder>();
     _builderPtr = _builder.get();
@@ -104,7 +150,12 @@ class Parser {
   }
 
   explicit Parser(Options const* options)
-      : _start(nullptr), _size(0), _pos(0), _nesting(0), options(options) {
+      : _start(nullptr),
+        _size(0),
+        _pos(0),
+        _nesting(0),
+        _structuralPos(0),
+        options(options) {
     if (VELOCYPACK_UNLIKELY(options == nullptr)) {
       throw Exception(Exception::InternalError, "Options cannot be a nullptr");
     }
@@ -121,6 +172,7 @@ class Parser {
         _size(0),
         _pos(0),
         _nesting(0),
+        _structuralPos(0),
         options(options) {
     if (VELOCYPACK_UNLIKELY(options == nullptr)) {
       throw Exception(Exception::InternalError, "Options cannot be a nullptr");
@@ -129,7 +181,12 @@ class Parser {
 
   // This method produces a parser that does not own the builder
   explicit Parser(Builder& builder, Options const* options = &Options::Defaults)
-      : _start(nullptr), _size(0), _pos(0), _nesting(0), options(options) {
+      : _start(nullptr),
+        _size(0),
+        _pos(0),
+        _nesting(0),
+        _structuralPos(0),
+        options(options) {
     if (VELOCYPACK_UNLIKELY(options == nullptr)) {
       throw Exception(Exception::InternalError, "Options cannot be a nullptr");
     }
@@ -160,6 +217,15 @@ class Parser {
     return parser.steal();
   }
 
+  // Parses newline-delimited JSON, i.e. one JSON value per line, and
+  // returns the values in input order. Lines that contain only
+  // whitespace are skipped. The lines are parsed in parallel on up to
+  // concurrency threads (0 means one per hardware thread). If any line
+  // cannot be parsed, the error of the first such line is rethrown.
+  static std::vector<SharedSlice> fromNdjson(
+      std::string_view ndjson, Options const* options = &Options::Defaults,
+      std::size_t concurrency = 0);
+
   ValueLength parse(std::string_view json, bool multi = false) {
     return parse(reinterpret_cast<uint8_t const*>(json.data()), json.size(),
                  multi);
@@ -181,8 +247,7 @@ class Parser {
     return parseInternal(multi);
   }
 
-  // We probably want a parse from stream at some stage...
-  // Not with this high-performance two-pass approach. :-(
+  // To parse input that arrives in chunks, use IncrementalParser.
 
   std::shared_ptr<Builder> steal() {
     // Parser object is broken after a steal()
@@ -223,6 +288,11 @@ class Parser {
 
   ValueLength parseInternal(bool multi);
 
+  // prepares the Builder for a top-level value. returns true if the
+  // value was reported to an open array in the Builder, in which case
+  // the Builder must be cleaned up if parsing fails
+  bool reportTopLevelValue();
+
   inline bool isWhiteSpace(uint8_t i) const noexcept {
     return (i == ' ' || i == '\t' || i == '\n' || i == '\r');
   }
@@ -256,36 +326,11 @@ class Parser {
     _builderPtr->addNull();
   }
 
-  void scanDigits(ParsedNumber& value) {
-    while (true) {
-      int i = consume();
-      if (i < 0) {
-        return;
-      }
-      if (i < '0' || i > '9') {
-        unconsume();
-        return;
-      }
-      value.addDigit(i);
-    }
-  }
+  // scans the integer digits of a number
+  void scanDigits(ParsedNumber& value);
 
-  double scanDigitsFractional() {
-    double pot = 0.1;
-    double x = 0.0;
-    while (true) {
-      int i = consume();
-      if (i < 0) {
-        return x;
-      }
-      if (i < '0' || i > '9') {
-        unconsume();
-        return x;
-      }
-      x = x + pot * (i - '0');
-      pot /= 10.0;
-    }
-  }
+  // scans the digits of the fractional part of a number
+  void scanDigitsFractional(ParsedNumber& value);
 
   inline int getOneOrThrow(char const* msg) {
     int i = consume();
@@ -301,13 +346,70 @@ class Parser {
 
   void parseNumber();
 
+  void addDouble(ParsedNumber const& value, bool negative,
+                 std::size_t startPos);
+
   void parseString();
 
   void parseArray();
 
-  void parseObject();
+  void parseArrayParallel();
+
+  // parses an object. if shape is set, the attribute names are first
+  // compared to those in it, and the shape is updated for the next object
+  void parseObject(KeyShape* shape = nullptr);
+
+  // returns the key shape for the members of an array at the current
+  // nesting depth
+  KeyShape& keyShape();
 
   void parseJson();
+
+  // adds the attribute name just written at keyPos to the Builder
+  // in its translated form, if a translation exists
+  void translateAttributeName(ValueLength keyPos);
+
+  // variants of the above used with the structural index
+
+  // returns the character at the next indexed position and moves _pos
+  // behind it, throws with err if there is none
+  int nextStructural(char const* err);
+
+  // returns the character at the next indexed position or -1, does not
+  // move
+  int peekStructural() const noexcept {
+    if (_structuralPos >= _structurals.size()) {
+      return -1;
+    }
+    return static_cast<int>(_start[_structurals[_structuralPos]]);
+  }
+
+  // throws unless a scalar value just parsed is followed by whitespace,
+  // the end of input or the next indexed position
+  void checkEndOfScalar();
+
+  void parseStringIndexed();
+
+  void parseArrayIndexed();
+
+  void parseObjectIndexed();
+
+  void parseJsonIndexed();
+
+  // variants of the above used with options->projection. they only build
+  // the parts of the value selected by projection, and return false if
+  // nothing was built
+  bool parseJsonProjected(AttributeProjection const& projection);
+
+  void parseArrayProjected(AttributeProjection const& projection);
+
+  void parseObjectProjected(AttributeProjection const& projection);
+
+  // skips over the next value without building it
+  void skipValue();
+
+  // skips over a string whose opening quote has been consumed
+  void skipString();
 };
 
 }  // namespace arangodb::velocypack
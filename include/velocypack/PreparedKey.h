@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/Options.h"
+#include "velocypack/Slice.h"
+
+namespace arangodb::velocypack {
+class AttributeTranslator;
+
+class PreparedKey {
+  // An attribute name in its final VPack encoding, for adding the same
+  // attribute name to many Objects. The encoding is determined once, with
+  // the attribute translator of the Options it is prepared with, so that
+  // Builder::add() only needs to copy it. A PreparedKey must only be used
+  // with Builders whose Options have the same attribute translator,
+  // Builder::add() throws otherwise.
+ public:
+  explicit PreparedKey(std::string_view name,
+                       Options const* options = &Options::Defaults);
+
+  // the attribute name
+  std::string_view name() const noexcept { return _name; }
+
+  // the encoded attribute name, a String or, if it was translated, an
+  // integer
+  Slice slice() const noexcept { return Slice(data()); }
+
+  uint8_t const* data() const noexcept {
+    return reinterpret_cast<uint8_t const*>(_encoded.data());
+  }
+
+  std::size_t size() const noexcept { return _encoded.size(); }
+
+  // the hash of the attribute name as a String, equal to hashString() of
+  // a String Slice with this name
+  uint64_t hash() const noexcept { return _hash; }
+
+  AttributeTranslator const* translator() const noexcept {
+    return _translator;
+  }
+
+ private:
+  std::string _name;
+  std::string _encoded;
+  uint64_t _hash;
+  AttributeTranslator const* _translator;
+};
+
+}  // namespace arangodb::velocypack
+
+using VPackPreparedKey = arangodb::velocypack::PreparedKey;
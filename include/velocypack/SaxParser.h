@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/Builder.h"
+#include "velocypack/Exception.h"
+#include "velocypack/Options.h"
+#include "velocypack/Parser.h"
+#include "velocypack/Slice.h"
+#include "velocypack/Value.h"
+#include "velocypack/ValueType.h"
+
+namespace arangodb::velocypack {
+
+template<typename Handler>
+class SaxParser {
+  // This class parses JSON like Parser does, but instead of building
+  // VPack it reports the parsed values as events to a handler. Handler
+  // must provide the following methods, which are called directly, i.e.
+  // without virtual dispatch:
+  //
+  //   void startObject();
+  //   void endObject();
+  //   void startArray();
+  //   void endArray();
+  //   void key(std::string_view name);
+  //   void string(std::string_view value);
+  //   void number(uint64_t value);  // non-negative integers
+  //   void number(int64_t value);   // negative integers
+  //   void number(double value);    // all other numbers
+  //   void boolean(bool value);
+  //   void null();
+  //
+  // The string_views passed to key() and string() are only valid during
+  // the call. Strings and numbers are scanned with the Parser's own code,
+  // so they are validated and converted exactly as by the Parser.
+  // Options::nestingLimit and Options::validateUtf8Strings are honored.
+  // Errors are reported by exceptions, as by the Parser. A handler can
+  // also stop parsing by throwing.
+
+  Handler& _handler;
+  // holds the last string or number scanned by the Parser
+  Builder _scratch;
+  Parser _parser;
+
+ public:
+  SaxParser(SaxParser const&) = delete;
+  SaxParser& operator=(SaxParser const&) = delete;
+
+  explicit SaxParser(Handler& handler,
+                     Options const* options = &Options::Defaults)
+      : _handler(handler), _scratch(options), _parser(_scratch, options) {}
+
+  Handler& handler() noexcept { return _handler; }
+
+  // parses exactly one JSON value, which may be surrounded by whitespace
+  void parse(std::string_view json) {
+    parse(reinterpret_cast<uint8_t const*>(json.data()), json.size());
+  }
+
+  void parse(char const* start, std::size_t size) {
+    parse(reinterpret_cast<uint8_t const*>(start), size);
+  }
+
+  void parse(uint8_t const* start, std::size_t size) {
+    _parser._start = start;
+    _parser._size = size;
+    _parser._pos = 0;
+    _parser._nesting = 0;
+
+    // skip over optional BOM
+    if (size >= 3 && start[0] == 0xef && start[1] == 0xbb &&
+        start[2] == 0xbf) {
+      _parser._pos += 3;
+    }
+
+    parseJson();
+
+    while (_parser._pos < size && _parser.isWhiteSpace(start[_parser._pos])) {
+      ++_parser._pos;
+    }
+    if (_parser._pos != size) {
+      _parser.consume();  // to get error reporting right
+      throw Exception(Exception::ParseError, "Expecting EOF");
+    }
+  }
+
+  // Returns the position at the time when the just reported error
+  // occurred, only use when handling an exception.
+  std::size_t errorPos() const { return _parser.errorPos(); }
+
+ private:
+  void parseJson() {
+    _parser.skipWhiteSpace("Expecting item");
+
+    int i = _parser.consume();
+    switch (i) {
+      case '{':
+        parseObject();
+        break;
+      case '[':
+        parseArray();
+        break;
+      case 't':
+        _scratch.clear();
+        _parser.parseTrue();
+        _handler.boolean(true);
+        break;
+      case 'f':
+        _scratch.clear();
+        _parser.parseFalse();
+        _handler.boolean(false);
+        break;
+      case 'n':
+        _scratch.clear();
+        _parser.parseNull();
+        _handler.null();
+        break;
+      case '"':
+        _handler.string(scanString());
+        break;
+      default:
+        _parser.unconsume();
+        scanNumber();
+        break;
+    }
+  }
+
+  void parseArray() {
+    _parser.increaseNesting();
+    _handler.startArray();
+
+    int i = _parser.skipWhiteSpace("Expecting item or ']'");
+    if (i != ']') {
+      while (true) {
+        parseJson();
+        i = _parser.skipWhiteSpace("Expecting ',' or ']'");
+        if (i == ']') {
+          break;
+        }
+        if (VELOCYPACK_UNLIKELY(i != ',')) {
+          throw Exception(Exception::ParseError, "Expecting ',' or ']'");
+        }
+        ++_parser._pos;  // the ','
+      }
+    }
+    ++_parser._pos;  // the closing ']'
+
+    _handler.endArray();
+    _parser.decreaseNesting();
+  }
+
+  void parseObject() {
+    _parser.increaseNesting();
+    _handler.startObject();
+
+    int i = _parser.skipWhiteSpace("Expecting item or '}'");
+    if (i != '}') {
+      while (true) {
+        // always expecting a string attribute name here
+        if (VELOCYPACK_UNLIKELY(i != '"')) {
+          throw Exception(Exception::ParseError, "Expecting '\"' or '}'");
+        }
+        ++_parser._pos;  // the initial '"'
+        _handler.key(scanString());
+
+        i = _parser.skipWhiteSpace("Expecting ':'");
+        if (VELOCYPACK_UNLIKELY(i != ':')) {
+          throw Exception(Exception::ParseError, "Expecting ':'");
+        }
+        ++_parser._pos;  // the colon
+
+        parseJson();
+
+        i = _parser.skipWhiteSpace("Expecting ',' or '}'");
+        if (i == '}') {
+          break;
+        }
+        if (VELOCYPACK_UNLIKELY(i != ',')) {
+          throw Exception(Exception::ParseError, "Expecting ',' or '}'");
+        }
+        ++_parser._pos;  // the ','
+        i = _parser.skipWhiteSpace("Expecting '\"' or '}'");
+      }
+    }
+    ++_parser._pos;  // the closing '}'
+
+    _handler.endObject();
+    _parser.decreaseNesting();
+  }
+
+  // scans the string behind the opening quote
+  std::string_view scanString() {
+    _scratch.clear();
+    _parser.parseString();
+    return Slice(_scratch.start()).stringView();
+  }
+
+  void scanNumber() {
+    _scratch.clear();
+    _parser.parseNumber();
+
+    Slice s(_scratch.start());
+    if (s.isDouble()) {
+      _handler.number(s.getDouble());
+    } else if (s.isType(ValueType::UInt)) {
+      _handler.number(s.getUInt());
+    } else {
+      int64_t value = s.getInt();
+      if (value >= 0) {
+        _handler.number(static_cast<uint64_t>(value));
+      } else {
+        _handler.number(value);
+      }
+    }
+  }
+};
+
+// SaxParser handler that builds VPack, with the same result as Parser
+// for values that do not need the Parser's special options
+class BuilderSaxHandler {
+ public:
+  explicit BuilderSaxHandler(Builder& builder) noexcept : _builder(builder) {}
+
+  void startObject() { _builder.openObject(); }
+  void endObject() { _builder.close(); }
+  void startArray() { _builder.openArray(); }
+  void endArray() { _builder.close(); }
+  void key(std::string_view name) { _builder.add(Value(name)); }
+  void string(std::string_view value) { _builder.add(Value(value)); }
+  void number(uint64_t value) { _builder.add(Value(value)); }
+  void number(int64_t value) { _builder.add(Value(value)); }
+  void number(double value) { _builder.add(Value(value)); }
+  void boolean(bool value) { _builder.add(Value(value)); }
+  void null() { _builder.add(Value(ValueType::Null)); }
+
+ private:
+  Builder& _builder;
+};
+
+}  // namespace arangodb::velocypack
+
+template<typename Handler>
+using VPackSaxParser = arangodb::velocypack::SaxParser<Handler>;
+using VPackBuilderSaxHandler = arangodb::velocypack::BuilderSaxHandler;
@@ -52,8 +52,17 @@ struct Sink {
   }
 };
 
+// a Sink that can overwrite data it has written before
+struct SeekableSink : public Sink {
+  // the position the next byte is written to
+  virtual ValueLength position() const = 0;
+
+  // overwrites len bytes at pos, which must have been written before
+  virtual void writeAt(ValueLength pos, char const* p, ValueLength len) = 0;
+};
+
 template<typename T>
-struct ByteBufferSinkImpl final : public Sink {
+struct ByteBufferSinkImpl final : public SeekableSink {
   using Sink::append;
 
   explicit ByteBufferSinkImpl(Buffer<T>* buffer) : _buffer(buffer) {}
@@ -64,6 +73,13 @@ struct ByteBufferSinkImpl final : public Sink {
 
   void reserve(ValueLength len) final { _buffer->reserve(len); }
 
+  ValueLength position() const final { return _buffer->size(); }
+
+  void writeAt(ValueLength pos, char const* p, ValueLength len) final {
+    VELOCYPACK_ASSERT(pos + len <= _buffer->size());
+    std::memcpy(_buffer->data() + pos, p, checkOverflow(len));
+  }
+
  private:
   Buffer<T>* _buffer;
 };
@@ -71,7 +87,7 @@ struct ByteBufferSinkImpl final : public Sink {
 typedef ByteBufferSinkImpl<char> CharBufferSink;
 
 template<typename T>
-struct StringSinkImpl final : public Sink {
+struct StringSinkImpl final : public SeekableSink {
   using Sink::append;
 
   explicit StringSinkImpl(T* buffer) : _buffer(buffer) {}
@@ -90,6 +106,14 @@ struct StringSinkImpl final : public Sink {
     _buffer->reserve(checkOverflow(len));
   }
 
+  ValueLength position() const final { return _buffer->size(); }
+
+  void writeAt(ValueLength pos, char const* p, ValueLength len) final {
+    VELOCYPACK_ASSERT(pos + len <= _buffer->size());
+    _buffer->replace(checkOverflow(pos), checkOverflow(len), p,
+                     checkOverflow(len));
+  }
+
   void setBuffer(T* buffer) noexcept { _buffer = buffer; }
   
   T* getBuffer() const noexcept { return _buffer; }
@@ -209,6 +233,42 @@ struct StreamSinkImpl final : public Sink {
 typedef StreamSinkImpl<std::ostringstream> StringStreamSink;
 typedef StreamSinkImpl<std::ofstream> OutputFileStreamSink;
 
+// a Sink for streams that support seeking, e.g. file streams
+template<typename T>
+struct SeekableStreamSinkImpl final : public SeekableSink {
+  using Sink::append;
+
+  explicit SeekableStreamSinkImpl(T* stream) : _stream(stream) {}
+
+  void push_back(char c) final { _stream->put(c); }
+
+  void append(char const* p, ValueLength len) final {
+    _stream->write(p, static_cast<std::streamsize>(len));
+  }
+
+  void reserve(ValueLength) final {}
+
+  ValueLength position() const final {
+    auto const pos = _stream->tellp();
+    if (VELOCYPACK_UNLIKELY(pos == typename T::pos_type(-1))) {
+      throw Exception(Exception::InternalError, "Stream is not seekable");
+    }
+    return static_cast<ValueLength>(pos);
+  }
+
+  void writeAt(ValueLength pos, char const* p, ValueLength len) final {
+    auto const end = _stream->tellp();
+    _stream->seekp(static_cast<typename T::off_type>(pos));
+    _stream->write(p, static_cast<std::streamsize>(len));
+    _stream->seekp(end);
+  }
+
+ private:
+  T* _stream;
+};
+
+typedef SeekableStreamSinkImpl<std::ofstream> SeekableFileStreamSink;
+
 }  // namespace arangodb::velocypack
 
 using VPackSink = arangodb::velocypack::Sink;
@@ -219,3 +279,6 @@ using VPackSizeConstrainedStringSink =
 using VPackStringLengthSink = arangodb::velocypack::StringLengthSink;
 using VPackStringStreamSink = arangodb::velocypack::StringStreamSink;
 using VPackOutputFileStreamSink = arangodb::velocypack::OutputFileStreamSink;
+using VPackSeekableSink = arangodb::velocypack::SeekableSink;
+using VPackSeekableFileStreamSink =
+    arangodb::velocypack::SeekableFileStreamSink;
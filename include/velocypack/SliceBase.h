@@ -32,6 +32,7 @@
 #include <iosfwd>
 #include <iterator>
 #include <limits>
+#include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -511,6 +512,13 @@ struct SliceBase {
   // returns a Slice(ValueType::None) if not found
   SliceType get(std::string_view attribute) const;
 
+  // look for several attributes inside an Object at once, and store the
+  // value of attributes[i] in values[i], or a Slice(ValueType::None) if
+  // not found. the attributes are sorted once, so that the Object is
+  // walked only once instead of being searched for each attribute
+  void getMany(std::span<std::string_view const> attributes,
+               std::span<SliceType> values) const;
+
   [[deprecated]] SliceType get(HashedStringRef attribute) const {
     return get(std::string_view(attribute.data(), attribute.size()));
   }
@@ -22,6 +22,8 @@
 /// @author Max Neunhoeffer
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <memory>
+#include <numeric>
 #include <ostream>
 
 #include "velocypack/velocypack-common.h"
@@ -42,6 +44,11 @@ constexpr int64_t maxValues[] = {
     128,          32768,           8388608,          2147483648,
     549755813888, 140737488355328, 36028797018963968};
 
+// the head byte of a String of the given length
+constexpr uint8_t stringHead(std::size_t length) noexcept {
+  return length <= 126 ? static_cast<uint8_t>(0x40 + length) : 0xbf;
+}
+
 }  // namespace
 
 namespace arangodb::velocypack {
@@ -337,6 +344,96 @@ SliceType SliceBase<DerivedType, SliceType>::get(
   return searchObjectKeyLinear(attribute, ieBase, offsetSize, n);
 }
 
+template<typename DerivedType, typename SliceType>
+void SliceBase<DerivedType, SliceType>::getMany(
+    std::span<std::string_view const> attributes,
+    std::span<SliceType> values) const {
+  if (VELOCYPACK_UNLIKELY(!isObject())) {
+    throw Exception(Exception::InvalidValueType, "Expecting Object");
+  }
+  if (VELOCYPACK_UNLIKELY(attributes.size() != values.size())) {
+    throw Exception(Exception::IndexOutOfBounds,
+                    "Expecting as many values as attributes");
+  }
+
+  std::fill(values.begin(), values.end(), SliceType());
+  std::size_t const k = attributes.size();
+  auto const h = head();
+  if (k == 0 || h == 0x0a) {
+    return;
+  }
+
+  ValueLength const n = length();
+  bool const sorted = (h >= 0x0b && h <= 0x0e && n > 1);
+  if (sorted && n / k >= 8) {
+    // few attributes in a large Object. a binary search per attribute
+    // is cheaper than walking the whole index table
+    for (std::size_t i = 0; i < k; ++i) {
+      values[i] = get(attributes[i]);
+    }
+    return;
+  }
+
+  // positions of the attributes, in the order of their names
+  constexpr std::size_t maxStackAttributes = 32;
+  std::size_t stackOrder[maxStackAttributes];
+  std::unique_ptr<std::size_t[]> heapOrder;
+  std::size_t* order = stackOrder;
+  if (k > maxStackAttributes) {
+    heapOrder = std::make_unique_for_overwrite<std::size_t[]>(k);
+    order = heapOrder.get();
+  }
+  std::iota(order, order + k, std::size_t(0));
+  std::sort(order, order + k, [&](std::size_t a, std::size_t b) {
+    return attributes[a] < attributes[b];
+  });
+
+  if (sorted) {
+    // merge the sorted attributes with the sorted index table
+    ValueLength const offsetSize = indexEntrySize(h);
+    ValueLength const end =
+        readIntegerNonEmpty<ValueLength>(start() + 1, offsetSize);
+    ValueLength const ieBase =
+        end - n * offsetSize - (offsetSize == 8 ? offsetSize : 0);
+    std::size_t j = 0;
+    for (ValueLength index = 0; index < n && j < k; ++index) {
+      Slice key(start() + readIntegerNonEmpty<ValueLength>(
+                              start() + ieBase + index * offsetSize,
+                              offsetSize));
+      std::string_view name = key.makeKey().stringView();
+      while (j < k && attributes[order[j]] < name) {
+        ++j;
+      }
+      while (j < k && attributes[order[j]] == name) {
+        values[order[j]] = make(key.start() + key.byteSize());
+        ++j;
+      }
+    }
+    return;
+  }
+
+  // a single scan over the members, looking up each name among the
+  // sorted attributes. of duplicate names, the first one is found
+  std::size_t missing = k;
+  ObjectIterator it(Slice(start()), /*useSequentialIteration*/ true);
+  while (it.valid() && missing > 0) {
+    Slice key = it.key(false);
+    std::string_view name = key.makeKey().stringView();
+    std::size_t* pos = std::lower_bound(
+        order, order + k, name, [&](std::size_t a, std::string_view b) {
+          return attributes[a] < b;
+        });
+    while (pos != order + k && attributes[*pos] == name) {
+      if (values[*pos].isNone()) {
+        values[*pos] = make(key.start() + key.byteSize());
+        --missing;
+      }
+      ++pos;
+    }
+    it.next();
+  }
+}
+
 // return the value for an Int object
 template<typename DerivedType, typename SliceType>
 int64_t SliceBase<DerivedType, SliceType>::getIntUnchecked() const noexcept {
@@ -507,14 +604,26 @@ bool SliceBase<DerivedType, SliceType>::isEqualStringUnchecked(
 template<typename DerivedType, typename SliceType>
 SliceType SliceBase<DerivedType, SliceType>::getFromCompactObject(
     std::string_view attribute) const {
-  ObjectIterator it(Slice(start()), /*useSequentialIteration*/ false);
-  while (it.valid()) {
-    Slice key = it.key(false);
-    if (key.makeKey().isEqualString(attribute)) {
+  ValueLength const end = readVariableValueLength<false>(start() + 1);
+  ValueLength const n = readVariableValueLength<true>(start() + end - 1);
+  uint8_t const target = stringHead(attribute.size());
+
+  ValueLength offset = 1 + getVariableValueLength(end);
+  for (ValueLength index = 0; index < n; ++index) {
+    Slice key(start() + offset);
+    auto const h = key.head();
+    // a String key can only be equal if it has the same head byte, which
+    // encodes the length of short Strings
+    if (h == target) {
+      if (key.isEqualStringUnchecked(attribute)) {
+        return SliceType(key.start() + key.byteSize());
+      }
+    } else if (!key.isString() && key.makeKey().isEqualString(attribute)) {
+      // translated key
       return SliceType(key.start() + key.byteSize());
     }
-
-    it.next();
+    offset += key.byteSize();
+    offset += Slice(start() + offset).byteSize();
   }
   // not found
   return SliceType();
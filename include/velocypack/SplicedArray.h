@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/Options.h"
+#include "velocypack/Sink.h"
+#include "velocypack/Slice.h"
+
+namespace arangodb::velocypack {
+
+class SplicedArray {
+  // An Array whose members are sealed VPack values in other buffers, for
+  // example the slices of Builders filled on different threads. The
+  // format of the Array, its header and its index table are computed up
+  // front, with the same rules as in Builder::close(), so the byte size
+  // of the Array is known before anything is copied. Builder::add() then
+  // reserves exactly this size and copies each member once. forEachPiece()
+  // hands out the header, the members and the index table in order
+  // instead, so that a scatter-gather writer does not need to copy the
+  // members at all. The members are referenced, not copied, so their
+  // buffers must outlive the SplicedArray.
+ public:
+  explicit SplicedArray(std::span<Slice const> members,
+                        Options const* options = &Options::Defaults);
+
+  // byte size of the Array
+  ValueLength byteSize() const noexcept { return _byteSize; }
+
+  // number of members
+  std::size_t length() const noexcept { return _members.size(); }
+
+  // calls cb(uint8_t const* data, ValueLength size) for all pieces of the
+  // Array in order
+  template<typename F>
+  void forEachPiece(F&& cb) const {
+    cb(_head.data(), static_cast<ValueLength>(_headSize));
+    for (auto const& member : _members) {
+      if (member.second != 0) {
+        cb(member.first, member.second);
+      }
+    }
+    if (!_tail.empty()) {
+      cb(_tail.data(), static_cast<ValueLength>(_tail.size()));
+    }
+  }
+
+  // writes the Array to out, which must have room for byteSize() bytes
+  void writeTo(uint8_t* out) const;
+
+  // appends the Array to sink
+  void writeTo(Sink& sink) const;
+
+  // whether one of the members is a Custom value
+  bool hasCustomMember() const noexcept;
+
+ private:
+  // uses the compact format, if the byte length fits into it
+  bool buildCompact(ValueLength totalSize);
+  void buildIndexed(ValueLength totalSize, Options const* options);
+
+  // start and byte size of all members
+  std::vector<std::pair<uint8_t const*, ValueLength>> _members;
+  // head byte, byte length, number of members and padding
+  std::array<uint8_t, 9> _head;
+  uint8_t _headSize;
+  // index table and trailing number of members
+  std::vector<uint8_t> _tail;
+  ValueLength _byteSize;
+};
+
+}  // namespace arangodb::velocypack
+
+using VPackSplicedArray = arangodb::velocypack::SplicedArray;
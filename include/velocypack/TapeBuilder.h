@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/Builder.h"
+#include "velocypack/Options.h"
+#include "velocypack/Slice.h"
+#include "velocypack/Value.h"
+
+namespace arangodb::velocypack {
+
+class TapeBuilder {
+  // This class builds VPack in two passes. The first pass records all
+  // values in a tape, and computes the exact byte size and format of
+  // each Array and Object when it is closed. The second pass, writeTo(),
+  // then writes the final VPack front to back. Unlike the Builder, this
+  // never needs to move already written data, and never leaves padding
+  // behind headers. Options::paddingBehavior is therefore ignored, all
+  // other options are honored as by the Builder.
+
+  struct Node {
+    // final byte size of the value
+    ValueLength size;
+    // scalars and attribute names: position of their VPack in _values.
+    // Arrays and Objects: index of the node behind their last member
+    ValueLength offset;
+    // Arrays and Objects: number of members
+    ValueLength items;
+    // Arrays and Objects: head byte. 0 for all other values
+    uint8_t head;
+    // Arrays and Objects: members start after 8 zero bytes of padding,
+    // because the first member starts with a zero byte
+    bool padded;
+  };
+
+  struct OpenCompound {
+    std::size_t node;
+    bool unindexed;
+  };
+
+  // VPack of all scalars and attribute names
+  Builder _values;
+  std::vector<Node> _nodes;
+  std::vector<OpenCompound> _stack;
+  // offsets of the members of all Arrays and Objects being written
+  mutable std::vector<ValueLength> _offsets;
+  // attribute names and offsets of the Object whose index table is
+  // being written
+  mutable std::vector<std::pair<std::string_view, ValueLength>> _sortEntries;
+  bool _keyWritten;
+
+ public:
+  Options const* options;
+
+  TapeBuilder(TapeBuilder const&) = delete;
+  TapeBuilder& operator=(TapeBuilder const&) = delete;
+
+  explicit TapeBuilder(Options const* options = &Options::Defaults);
+
+  void clear() noexcept;
+
+  bool isClosed() const noexcept { return _stack.empty(); }
+
+  bool isEmpty() const noexcept { return _nodes.empty(); }
+
+  void openArray(bool unindexed = false) {
+    add(Value(ValueType::Array, unindexed));
+  }
+
+  void openObject(bool unindexed = false) {
+    add(Value(ValueType::Object, unindexed));
+  }
+
+  void close();
+
+  // adds a value to the open Array, as the attribute name or value in
+  // the open Object, or as a top-level value. Values of type Array and
+  // Object open a new Array or Object
+  void add(Value const& sub);
+
+  void add(Slice sub);
+
+  void add(std::string_view attrName, Value const& sub) {
+    addKey(attrName);
+    add(sub);
+  }
+
+  void add(std::string_view attrName, Slice sub) {
+    addKey(attrName);
+    add(sub);
+  }
+
+  // Returns the byte size of all top-level values, if the tape is closed
+  ValueLength size() const;
+
+  // Appends the VPack of all top-level values to builder, which must not
+  // have an open Array or Object. The tape must be closed.
+  void writeTo(Builder& builder) const;
+
+ private:
+  void addKey(std::string_view attrName);
+
+  // prepares adding a value, returns true if it is an attribute name
+  bool reportAdd(bool isValidKey);
+
+  void addScalar(ValueLength start);
+
+  void openCompound(bool isArray, bool unindexed);
+
+  // computes the format and byte size of a compound whose members are
+  // all recorded
+  void closeCompound(Node& node, bool unindexed);
+
+  void checkAttributeUniqueness(Node const& node) const;
+
+  // writes the node at index and all of its members to out, moves out
+  // behind them and returns the index of the next node
+  std::size_t write(std::size_t index, uint8_t*& out) const;
+
+  // writes an Array member, or an attribute name and its value
+  std::size_t writeMember(std::size_t index, uint8_t*& out,
+                          bool isArray) const;
+};
+
+}  // namespace arangodb::velocypack
+
+using VPackTapeBuilder = arangodb::velocypack::TapeBuilder;
@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <array>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/ArrayStreamer.h"
+#include "velocypack/Exception.h"
+
+using namespace arangodb::velocypack;
+
+namespace {
+
+// the header of a compact Array with n > 0 members of membersSize bytes
+// in total. returns the byte size of the Array, and stores the header in
+// head and its length in headSize
+ValueLength compactHeader(ValueLength membersSize, ValueLength n,
+                          std::array<uint8_t, 9>& head,
+                          ValueLength& headSize) {
+  ValueLength byteSize = 1 + membersSize + getVariableValueLength(n);
+  ValueLength bLen = getVariableValueLength(byteSize);
+  byteSize += bLen;
+  if (getVariableValueLength(byteSize) != bLen) {
+    byteSize += 1;
+    bLen += 1;
+  }
+  if (VELOCYPACK_UNLIKELY(bLen >= 9)) {
+    throw Exception(Exception::NumberOutOfRange,
+                    "Array too large for the compact format");
+  }
+  head[0] = 0x13;
+  storeVariableValueLength<false>(head.data() + 1, byteSize);
+  headSize = 1 + bLen;
+  return byteSize;
+}
+
+// writes the number of members behind the members of a compact Array
+void appendLength(Sink& sink, ValueLength n) {
+  std::array<uint8_t, 10> tail;
+  ValueLength const nLen = getVariableValueLength(n);
+  storeVariableValueLength<true>(tail.data() + nLen - 1, n);
+  sink.append(reinterpret_cast<char const*>(tail.data()), nLen);
+}
+
+// the member built in builder, which must be closed
+Slice builtMember(Builder const& builder) {
+  if (VELOCYPACK_UNLIKELY(builder.isEmpty())) {
+    throw Exception(Exception::BuilderUnexpectedValue,
+                    "Array member must not be empty");
+  }
+  if (VELOCYPACK_UNLIKELY(!builder.isClosed())) {
+    throw Exception(Exception::BuilderNotSealed);
+  }
+  return builder.slice();
+}
+
+}  // namespace
+
+ArrayStreamer::ArrayStreamer(SeekableSink& sink, Options const* options)
+    : _builder(options),
+      _sink(sink),
+      _start(sink.position()),
+      _membersSize(0),
+      _length(0),
+      _finished(false) {
+  // room for the largest header
+  std::array<char, 9> const zeros{};
+  _sink.append(zeros.data(), zeros.size());
+}
+
+void ArrayStreamer::next() {
+  add(builtMember(_builder));
+  _builder.clear();
+}
+
+void ArrayStreamer::add(Slice member) {
+  if (VELOCYPACK_UNLIKELY(_finished)) {
+    throw Exception(Exception::BuilderNeedOpenArray);
+  }
+  _sink.append(reinterpret_cast<char const*>(member.start()),
+               member.byteSize());
+  _membersSize += member.byteSize();
+  ++_length;
+}
+
+ValueLength ArrayStreamer::finish() {
+  if (VELOCYPACK_UNLIKELY(_finished)) {
+    throw Exception(Exception::BuilderNeedOpenArray);
+  }
+  _finished = true;
+
+  if (_length == 0) {
+    // an empty Array
+    _sink.writeAt(_start + 8, "\x01", 1);
+    return 8;
+  }
+  appendLength(_sink, _length);
+  std::array<uint8_t, 9> head;
+  ValueLength headSize;
+  compactHeader(_membersSize, _length, head, headSize);
+  ValueLength const offset = 9 - headSize;
+  _sink.writeAt(_start + offset, reinterpret_cast<char const*>(head.data()),
+                headSize);
+  return offset;
+}
+
+ArrayBatchStreamer::ArrayBatchStreamer(Sink& sink, ValueLength flushSize,
+                                       Options const* options)
+    : _builder(options),
+      _sink(sink),
+      _flushSize(flushSize),
+      _length(0),
+      _pendingLength(0),
+      _numArrays(0),
+      _finished(false) {}
+
+void ArrayBatchStreamer::next() {
+  add(builtMember(_builder));
+  _builder.clear();
+}
+
+void ArrayBatchStreamer::add(Slice member) {
+  if (VELOCYPACK_UNLIKELY(_finished)) {
+    throw Exception(Exception::BuilderNeedOpenArray);
+  }
+  _pending.append(member.start(), member.byteSize());
+  ++_length;
+  ++_pendingLength;
+  if (_pending.size() >= _flushSize) {
+    flush();
+  }
+}
+
+void ArrayBatchStreamer::flush() {
+  if (_pendingLength == 0) {
+    return;
+  }
+  std::array<uint8_t, 9> head;
+  ValueLength headSize;
+  ValueLength const byteSize =
+      compactHeader(_pending.size(), _pendingLength, head, headSize);
+  _sink.reserve(byteSize);
+  _sink.append(reinterpret_cast<char const*>(head.data()), headSize);
+  _sink.append(reinterpret_cast<char const*>(_pending.data()),
+               _pending.size());
+  appendLength(_sink, _pendingLength);
+  _pending.reset();
+  _pendingLength = 0;
+  ++_numArrays;
+}
+
+void ArrayBatchStreamer::finish() {
+  if (VELOCYPACK_UNLIKELY(_finished)) {
+    throw Exception(Exception::BuilderNeedOpenArray);
+  }
+  _finished = true;
+
+  if (_length == 0) {
+    // an empty Array
+    _sink.push_back(0x01);
+    ++_numArrays;
+  } else {
+    flush();
+  }
+}
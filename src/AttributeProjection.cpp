@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/AttributeProjection.h"
+
+using namespace arangodb::velocypack;
+
+void AttributeProjection::add(std::vector<std::string_view> const& path) {
+  AttributeProjection* node = this;
+  for (auto const& name : path) {
+    if (node->_all) {
+      // a prefix of the path is selected already
+      return;
+    }
+    AttributeProjection* child = nullptr;
+    for (auto& it : node->_children) {
+      if (it.first == name) {
+        child = it.second.get();
+        break;
+      }
+    }
+    if (child == nullptr) {
+      node->_children.emplace_back(std::string(name),
+                                   std::make_unique<AttributeProjection>());
+      child = node->_children.back().second.get();
+    }
+    node = child;
+  }
+  // the value is selected as a whole, so its subpaths are not needed
+  node->_all = true;
+  node->_children.clear();
+}
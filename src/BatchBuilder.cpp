@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <cstring>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/BatchBuilder.h"
+#include "velocypack/Exception.h"
+
+using namespace arangodb::velocypack;
+
+BatchBuilder::BatchBuilder(Options const* options, ValueLength chunkSize)
+    : _builder(options), _chunkSize(chunkSize), _used(0), _numChunks(0) {
+  if (VELOCYPACK_UNLIKELY(chunkSize == 0)) {
+    throw Exception(Exception::InternalError, "Chunk size must not be 0");
+  }
+}
+
+SharedSlice BatchBuilder::finish() {
+  if (_builder.isEmpty()) {
+    return SharedSlice{};
+  }
+  if (VELOCYPACK_UNLIKELY(!_builder.isClosed())) {
+    throw Exception(Exception::BuilderNotSealed);
+  }
+
+  ValueLength const size = _builder.size();
+  std::shared_ptr<uint8_t> document = allocate(size);
+  std::memcpy(document.get(), _builder.data(), checkOverflow(size));
+  _builder.clear();
+  return SharedSlice(std::shared_ptr<uint8_t const>(std::move(document)));
+}
+
+SharedSlice BatchBuilder::add(Slice document) {
+  ValueLength const size = document.byteSize();
+  std::shared_ptr<uint8_t> copy = allocate(size);
+  std::memcpy(copy.get(), document.start(), checkOverflow(size));
+  return SharedSlice(std::shared_ptr<uint8_t const>(std::move(copy)));
+}
+
+std::shared_ptr<uint8_t> BatchBuilder::allocate(ValueLength size) {
+  if (size > _chunkSize / 4) {
+    // large documents get their own chunk, so that they do not leave
+    // most of the current chunk unused
+    auto chunk =
+        std::make_shared_for_overwrite<uint8_t[]>(checkOverflow(size));
+    ++_numChunks;
+    uint8_t* p = chunk.get();
+    return std::shared_ptr<uint8_t>(std::move(chunk), p);
+  }
+
+  if (_chunk == nullptr || _chunkSize - _used < size) {
+    _chunk =
+        std::make_shared_for_overwrite<uint8_t[]>(checkOverflow(_chunkSize));
+    _used = 0;
+    ++_numChunks;
+  }
+  uint8_t* p = _chunk.get() + _used;
+  _used += size;
+  return std::shared_ptr<uint8_t>(_chunk, p);
+}
@@ -22,10 +22,10 @@
 /// @author Jan Steemann
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <string_view>
-#include <unordered_set>
 
 #include "velocypack/velocypack-common.h"
 #include "velocypack/Builder.h"
@@ -33,6 +33,9 @@
 #include "velocypack/Iterator.h"
 #include "velocypack/Sink.h"
 
+#include "array-padding.h"
+#include "attribute-name-set.h"
+
 using namespace arangodb::velocypack;
 
 namespace {
@@ -42,22 +45,9 @@ bool isAllowedToMemmove(Options const* options, uint8_t const* start,
                         std::vector<ValueLength>::iterator indexStart,
                         std::vector<ValueLength>::iterator indexEnd,
                         ValueLength offsetSize) {
-  VELOCYPACK_ASSERT(offsetSize == 1 || offsetSize == 2);
-
-  if (options->paddingBehavior == Options::PaddingBehavior::NoPadding ||
-      (offsetSize == 1 &&
-       options->paddingBehavior == Options::PaddingBehavior::Flexible)) {
-    std::size_t const distance = std::distance(indexStart, indexEnd);
-    std::size_t const n = (std::min)(std::size_t(8 - 2 * offsetSize), distance);
-    for (std::size_t i = 0; i < n; i++) {
-      if (start[indexStart[i]] == 0x00) {
-        return false;
-      }
-    }
-    return true;
-  }
-
-  return false;
+  return allowsNoPadding(
+      options, std::distance(indexStart, indexEnd), offsetSize,
+      [&](std::size_t i) { return start[indexStart[i]]; });
 }
 
 uint8_t determineArrayType(bool needIndexTable, ValueLength offsetSize) {
@@ -81,13 +71,43 @@ uint8_t determineArrayType(bool needIndexTable, ValueLength offsetSize) {
 
 constexpr ValueLength linearAttributeUniquenessCutoff = 4;
 
+// Builder::getKey() scans Objects with up to this many members, and builds
+// a hash index of the attribute names of larger ones
+constexpr std::size_t keyIndexMinMembers = 8;
+
 // struct used when sorting index tables for objects:
 struct SortEntry {
   uint8_t const* nameStart;
   uint64_t nameSize;
   uint64_t offset;
+  // the first 8 bytes of the name in big-endian order, padded with
+  // zeros. most names can be ordered by comparing only these
+  uint64_t prefix;
 };
 
+uint64_t namePrefix(uint8_t const* name, uint64_t size) noexcept {
+  uint64_t prefix = 0;
+  for (std::size_t i = 0; i < 8; ++i) {
+    prefix = (prefix << 8) | (i < size ? name[i] : 0);
+  }
+  return prefix;
+}
+
+// returns true iff the name of a sorts before the name of b
+bool sortsBefore(SortEntry const& a, SortEntry const& b) noexcept {
+  if (a.prefix != b.prefix) {
+    return a.prefix < b.prefix;
+  }
+  if (a.nameSize <= 8 || b.nameSize <= 8) {
+    // the shorter name is a prefix of the other one
+    return a.nameSize < b.nameSize;
+  }
+  std::size_t const compareLength =
+      checkOverflow((std::min)(a.nameSize, b.nameSize) - 8);
+  int res = std::memcmp(a.nameStart + 8, b.nameStart + 8, compareLength);
+  return (res < 0 || (res == 0 && a.nameSize < b.nameSize));
+}
+
 // minimum allocation done for the sortEntries vector
 // this is used to overallocate memory so we can avoid some follow-up
 // reallocations
@@ -99,8 +119,7 @@ constexpr size_t minSortEntriesAllocation = 32;
 thread_local std::unique_ptr<std::vector<SortEntry>> sortEntries;
 
 // thread-local, reusable set to track usage of duplicate keys
-thread_local std::unique_ptr<std::unordered_set<std::string_view>>
-    duplicateKeys;
+thread_local std::unique_ptr<AttributeNameSet> duplicateKeys;
 
 #endif
 
@@ -153,22 +172,21 @@ bool checkAttributeUniquenessUnsortedBrute(ObjectIterator& it) {
 
 bool checkAttributeUniquenessUnsortedSet(ObjectIterator& it) {
 #ifndef VELOCYPACK_NO_THREADLOCALS
-  std::unique_ptr<std::unordered_set<std::string_view>>& tmp = ::duplicateKeys;
+  std::unique_ptr<AttributeNameSet>& tmp = ::duplicateKeys;
 
   if (::duplicateKeys == nullptr) {
-    ::duplicateKeys = std::make_unique<std::unordered_set<std::string_view>>();
-  } else {
-    ::duplicateKeys->clear();
+    ::duplicateKeys = std::make_unique<AttributeNameSet>();
   }
 #else
-  auto tmp = std::make_unique<std::unordered_set<std::string_view>>();
+  auto tmp = std::make_unique<AttributeNameSet>();
 #endif
+  tmp->reset(checkOverflow(it.size()));
 
   do {
     Slice key = it.key(true);
     // key(true) guarantees a String as returned type
     VELOCYPACK_ASSERT(key.isString());
-    if (VELOCYPACK_UNLIKELY(!tmp->emplace(key.stringView()).second)) {
+    if (VELOCYPACK_UNLIKELY(!tmp->insert(key.stringView()))) {
       // identical key
       return false;
     }
@@ -306,6 +324,7 @@ Builder& Builder::operator=(Builder const& that) {
     _stack = that._stack;
     _indexes = that._indexes;
     _keyWritten = that._keyWritten;
+    _keyIndex.depth = 0;
     options = that.options;
   }
   VELOCYPACK_ASSERT(options != nullptr);
@@ -358,6 +377,7 @@ Builder& Builder::operator=(Builder&& that) noexcept {
     _stack = std::move(that._stack);
     _indexes = std::move(that._indexes);
     _keyWritten = that._keyWritten;
+    _keyIndex.depth = 0;
     options = that.options;
     VELOCYPACK_ASSERT(that._buffer == nullptr);
     that._bufferPtr = nullptr;
@@ -427,28 +447,42 @@ void Builder::sortObjectIndexLong(
   std::size_t const n = std::distance(indexStart, indexEnd);
   VELOCYPACK_ASSERT(n > 1);
   tmp->reserve(std::max(::minSortEntriesAllocation, n));
+  // determine the length of the prefix that all names share, so that
+  // it can be skipped in all comparisons
+  uint64_t common = 0;
   for (std::size_t i = 0; i < n; i++) {
     SortEntry e;
     e.offset = indexStart[i];
     e.nameStart = ::findAttrName(objBase + e.offset, e.nameSize);
+    if (i == 0) {
+      common = e.nameSize;
+    } else {
+      uint8_t const* first = tmp->front().nameStart;
+      common = std::mismatch(first, first + (std::min)(common, e.nameSize),
+                             e.nameStart)
+                   .first -
+               first;
+    }
     tmp->push_back(e);
   }
   VELOCYPACK_ASSERT(tmp->size() == n);
-  std::sort(tmp->begin(), tmp->end(),
-            [](SortEntry const& a, SortEntry const& b)
-#ifdef VELOCYPACK_64BIT
-                noexcept
-#endif
-            {
-              // return true iff a < b:
-              uint64_t sizea = a.nameSize;
-              uint64_t sizeb = b.nameSize;
-              std::size_t const compareLength =
-                  checkOverflow((std::min)(sizea, sizeb));
-              int res = std::memcmp(a.nameStart, b.nameStart, compareLength);
-
-              return (res < 0 || (res == 0 && sizea < sizeb));
-            });
+
+  // keys generated in order are common, so check whether the index
+  // is sorted already
+  bool sorted = true;
+  for (std::size_t i = 0; i < n; i++) {
+    SortEntry& e = (*tmp)[i];
+    e.nameStart += common;
+    e.nameSize -= common;
+    e.prefix = ::namePrefix(e.nameStart, e.nameSize);
+    if (sorted && i > 0 && ::sortsBefore(e, (*tmp)[i - 1])) {
+      sorted = false;
+    }
+  }
+  if (sorted) {
+    return;
+  }
+  std::sort(tmp->begin(), tmp->end(), ::sortsBefore);
 
   // copy back the sorted offsets
   for (std::size_t i = 0; i < n; i++) {
@@ -465,6 +499,35 @@ Builder& Builder::closeEmptyArrayOrObject(ValueLength pos, bool isArray) {
   return *this;
 }
 
+bool Builder::selectsCompactFormat(
+    ValueLength pos, bool isArray,
+    std::vector<ValueLength>::iterator indexStart,
+    std::vector<ValueLength>::iterator indexEnd) const {
+  std::size_t const n = std::distance(indexStart, indexEnd);
+  if (n > options->compactFormatMaxMembers &&
+      _pos - (pos + 9) > options->compactFormatMaxByteSize) {
+    return false;
+  }
+  if (isArray) {
+    // an Array whose members all have the same size needs no index table,
+    // and is smaller than in the compact format
+    if (n == 1) {
+      return false;
+    }
+    ValueLength const subLen = indexStart[1] - indexStart[0];
+    if ((_pos - pos) - indexStart[n - 1] != subLen) {
+      return true;
+    }
+    for (std::size_t i = 1; i < n - 1; ++i) {
+      if (indexStart[i + 1] - indexStart[i] != subLen) {
+        return true;
+      }
+    }
+    return false;
+  }
+  return true;
+}
+
 bool Builder::closeCompactArrayOrObject(
     ValueLength pos, bool isArray,
     std::vector<ValueLength>::iterator indexStart,
@@ -699,9 +762,18 @@ Builder& Builder::close() {
   VELOCYPACK_ASSERT(n > 0);
 
   // check if we can use the compact Array / Object format
-  if (head == 0x13 || head == 0x14 ||
-      (head == 0x06 && options->buildUnindexedArrays) ||
-      (head == 0x0b && (options->buildUnindexedObjects || n == 1))) {
+  bool compact;
+  if (head == 0x13 || head == 0x14 || (head == 0x0b && n == 1)) {
+    compact = true;
+  } else if (_stack.back().randomAccess) {
+    compact = false;
+  } else if (options->selectCompactFormat) {
+    compact = selectsCompactFormat(pos, isArray, indexStart, indexEnd);
+  } else {
+    compact = isArray ? options->buildUnindexedArrays
+                      : options->buildUnindexedObjects;
+  }
+  if (compact) {
     if (closeCompactArrayOrObject(pos, isArray, indexStart, indexEnd)) {
       // And, if desired, check attribute uniqueness:
       if ((head == 0x0b || head == 0x14) && options->checkAttributeUniqueness &&
@@ -869,9 +941,16 @@ Slice Builder::getKey(std::string_view key) const {
   if (VELOCYPACK_UNLIKELY(_start[pos] != 0x0b && _start[pos] != 0x14)) {
     throw Exception(Exception::BuilderNeedOpenObject);
   }
+  // members whose value has not been written yet are left out
+  std::size_t const n =
+      _indexes.size() - indexStartPos - (_keyWritten ? 1 : 0);
+  if (n > ::keyIndexMinMembers) {
+    return getKeyIndexed(key, pos, n);
+  }
+
   std::vector<ValueLength>::const_iterator indexStart =
       _indexes.begin() + indexStartPos;
-  std::vector<ValueLength>::const_iterator indexEnd = _indexes.end();
+  std::vector<ValueLength>::const_iterator indexEnd = indexStart + n;
   while (indexStart != indexEnd) {
     Slice s(_start + pos + *indexStart);
     if (s.makeKey().isEqualString(key)) {
@@ -882,6 +961,73 @@ Slice Builder::getKey(std::string_view key) const {
   return Slice();
 }
 
+Slice Builder::getKeyIndexed(std::string_view key, ValueLength pos,
+                             std::size_t n) const {
+  auto& slots = _keyIndex.slots;
+  if (_keyIndex.depth != _stack.size() || _keyIndex.members > n) {
+    // the index belongs to another Object, or members were removed
+    _keyIndex.depth = _stack.size();
+    _keyIndex.members = 0;
+    std::fill(slots.begin(), slots.end(),
+              std::make_pair(uint64_t(0), ValueLength(0)));
+  }
+
+  auto nameAt = [this, pos](ValueLength offset) {
+    return Slice(_start + pos + offset).makeKey().stringView();
+  };
+
+  if (slots.size() < 2 * n) {
+    // grow to at least twice the number of members, and rehash
+    std::size_t capacity = slots.empty() ? 32 : slots.size();
+    while (capacity < 2 * n) {
+      capacity *= 2;
+    }
+    std::vector<std::pair<uint64_t, ValueLength>> previous(capacity);
+    previous.swap(slots);
+    for (auto const& slot : previous) {
+      if (slot.second != 0) {
+        std::size_t i = static_cast<std::size_t>(slot.first) & (capacity - 1);
+        while (slots[i].second != 0) {
+          i = (i + 1) & (capacity - 1);
+        }
+        slots[i] = slot;
+      }
+    }
+  }
+  std::size_t const mask = slots.size() - 1;
+
+  // add the members added since the last lookup
+  ValueLength const* offsets =
+      _indexes.data() + _stack.back().indexStartPos;
+  for (; _keyIndex.members < n; ++_keyIndex.members) {
+    ValueLength const offset = offsets[_keyIndex.members];
+    std::string_view const name = nameAt(offset);
+    uint64_t const hash = VELOCYPACK_HASH(name.data(), name.size(), 0xdeadbeef);
+    std::size_t i = static_cast<std::size_t>(hash) & mask;
+    while (slots[i].second != 0) {
+      if (slots[i].first == hash && nameAt(slots[i].second - 1) == name) {
+        // keep the first member with this name, as the linear scan does
+        break;
+      }
+      i = (i + 1) & mask;
+    }
+    if (slots[i].second == 0) {
+      slots[i] = std::make_pair(hash, offset + 1);
+    }
+  }
+
+  uint64_t const hash = VELOCYPACK_HASH(key.data(), key.size(), 0xdeadbeef);
+  std::size_t i = static_cast<std::size_t>(hash) & mask;
+  while (slots[i].second != 0) {
+    if (slots[i].first == hash && nameAt(slots[i].second - 1) == key) {
+      Slice s(_start + pos + slots[i].second - 1);
+      return Slice(s.start() + s.byteSize());
+    }
+    i = (i + 1) & mask;
+  }
+  return Slice();
+}
+
 void Builder::appendTag(uint64_t tag) {
   if (options->disallowTags) {
     // Tagged values explicitly disallowed
@@ -1183,6 +1329,22 @@ uint8_t* Builder::set(Slice const& item) {
   return _start + _pos - l;
 }
 
+uint8_t* Builder::set(SplicedArray const& item) {
+  checkKeyHasValidType(false);
+
+  if (VELOCYPACK_UNLIKELY(options->disallowCustom &&
+                          item.hasCustomMember())) {
+    // Custom values explicitly disallowed as a security precaution
+    throw Exception(Exception::BuilderCustomDisallowed);
+  }
+
+  ValueLength const l = item.byteSize();
+  reserve(l);
+  item.writeTo(_start + _pos);
+  advance(l);
+  return _start + _pos - l;
+}
+
 uint8_t* Builder::set(ValuePair const& pair) {
   // This method builds a single further VPack item at the current
   // append position. This is the case for ValueType::String,
@@ -1288,6 +1450,10 @@ void Builder::reportAdd() {
 
 void Builder::closeLevel() noexcept {
   VELOCYPACK_ASSERT(!_stack.empty());
+  if (_stack.size() <= _keyIndex.depth) {
+    // the indexed Object is closed
+    _keyIndex.depth = 0;
+  }
   ValueLength const indexStartPos = _stack.back().indexStartPos;
   _stack.pop_back();
   _indexes.erase(_indexes.begin() + indexStartPos, _indexes.end());
@@ -1343,8 +1509,7 @@ bool Builder::checkAttributeUniquenessUnsorted(Slice obj) const {
   // unsorted objects with this amount of attributes (or less) will
   // be validated using a non-allocating scan over the attributes
   // objects with more attributes will use a validation routine that
-  // will use an std::unordered_set for O(1) lookups but with heap
-  // allocations
+  // will use a reusable hash set for O(1) lookups
   ObjectIterator it(obj, true);
 
   if (it.size() <= ::linearAttributeUniquenessCutoff) {
@@ -1394,6 +1559,135 @@ uint8_t* Builder::add(ArrayIterator&& sub) {
   return _start + oldPos;
 }
 
+uint8_t* Builder::addArray(std::span<int64_t const> values) {
+  return addArrayOf(values);
+}
+
+uint8_t* Builder::addArray(std::span<uint64_t const> values) {
+  return addArrayOf(values);
+}
+
+uint8_t* Builder::addArray(std::span<double const> values) {
+  return addArrayOf(values);
+}
+
+uint8_t* Builder::addObject(std::span<std::string_view const> names,
+                            std::span<std::span<int64_t const> const> columns) {
+  return addObjectOf(names, columns);
+}
+
+uint8_t* Builder::addObject(
+    std::span<std::string_view const> names,
+    std::span<std::span<uint64_t const> const> columns) {
+  return addObjectOf(names, columns);
+}
+
+uint8_t* Builder::addObject(std::span<std::string_view const> names,
+                            std::span<std::span<double const> const> columns) {
+  return addObjectOf(names, columns);
+}
+
+template<typename T>
+uint8_t* Builder::addArrayOf(std::span<T const> values) {
+  // reserve everything up front, so that nothing fails after the array
+  // has been opened. each value takes at most 9 bytes
+  reserve(9 + 9 * values.size());
+  _indexes.reserve(_indexes.size() + values.size() + 1);
+  add(Value(ValueType::Array));
+  ValueLength const pos = _stack.back().startPos;
+  fillArray(values);
+  return _start + pos;
+}
+
+template<typename T>
+uint8_t* Builder::addObjectOf(std::span<std::string_view const> names,
+                              std::span<std::span<T const> const> columns) {
+  if (VELOCYPACK_UNLIKELY(names.size() != columns.size())) {
+    throw Exception(Exception::BuilderUnexpectedValue,
+                    "Number of column names and columns differ");
+  }
+  add(Value(ValueType::Object));
+  ValueLength const pos = _stack.back().startPos;
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    _indexes.reserve(_indexes.size() + columns[i].size() + 1);
+    add(names[i], Value(ValueType::Array));
+    // the name and the array header are written now. each value takes
+    // at most 9 bytes
+    reserve(9 * columns[i].size());
+    fillArray(columns[i]);
+  }
+  close();
+  return _start + pos;
+}
+
+template<typename T>
+void Builder::fillArray(std::span<T const> values) {
+  std::size_t const n = values.size();
+  std::size_t const first = _indexes.size();
+  _indexes.resize(first + n);
+  ValueLength* index = _indexes.data() + first;
+  uint8_t const* base = _start + _stack.back().startPos;
+  uint8_t* p = _start + _pos;
+
+  if constexpr (std::is_same_v<T, double>) {
+    // all doubles take 9 bytes
+    ValueLength const offset = static_cast<ValueLength>(p - base);
+    for (std::size_t i = 0; i < n; ++i) {
+      index[i] = offset + 9 * i;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+      uint64_t dv;
+      memcpy(&dv, &values[i], sizeof(double));
+      dv = hostToLittle(dv);
+      p[0] = 0x1b;
+      memcpy(p + 1, &dv, sizeof(double));
+      p += 9;
+    }
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      index[i] = static_cast<ValueLength>(p - base);
+      T const v = values[i];
+      if constexpr (std::is_signed_v<T>) {
+        if (v >= -6 && v <= 9) {
+          // SmallInt
+          *p++ = static_cast<uint8_t>(v >= 0 ? 0x30 + v : 0x40 + v);
+          continue;
+        }
+        uint8_t vSize = intLength(v);
+        uint64_t x;
+        if (vSize == 8) {
+          x = toUInt64(v);
+        } else {
+          int64_t shift = 1LL << (vSize * 8 - 1);  // will never overflow!
+          x = v >= 0 ? static_cast<uint64_t>(v)
+                     : static_cast<uint64_t>(v + shift) + shift;
+        }
+        *p++ = 0x1f + vSize;
+        for (; vSize > 0; --vSize) {
+          *p++ = static_cast<uint8_t>(x & 0xff);
+          x >>= 8;
+        }
+      } else {
+        if (v <= 9) {
+          // SmallInt
+          *p++ = static_cast<uint8_t>(0x30 + v);
+          continue;
+        }
+        uint8_t* head = p++;
+        uint64_t x = v;
+        do {
+          *p++ = static_cast<uint8_t>(x & 0xff);
+          x >>= 8;
+        } while (x != 0);
+        *head = static_cast<uint8_t>(0x27 + (p - head - 1));
+      }
+    }
+  }
+
+  advance(static_cast<std::size_t>(p - (_start + _pos)));
+  close();
+}
+
 ValueLength Builder::effectivePaddingForOneByteMembers() const noexcept {
   // 8 bytes - object length (1 byte) - number of items (1 byte) = 6 bytes
   return (options->paddingBehavior == Options::PaddingBehavior::UsePadding ? 6
@@ -0,0 +1,127 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/CompiledPath.h"
+#include "velocypack/Exception.h"
+
+using namespace arangodb::velocypack;
+
+namespace {
+
+bool isKey(Slice key, std::string_view name) {
+  return key.makeKey().stringView() == name;
+}
+
+}  // namespace
+
+CompiledPath::CompiledPath(std::vector<std::string_view> const& path)
+    : _hits(0), _misses(0) {
+  if (VELOCYPACK_UNLIKELY(path.empty())) {
+    throw Exception(Exception::InvalidAttributePath);
+  }
+  _steps.reserve(path.size());
+  for (auto const& name : path) {
+    _steps.push_back(Step{std::string(name), 0});
+  }
+}
+
+Slice CompiledPath::get(Slice slice, bool resolveExternals) {
+  if (resolveExternals) {
+    slice = slice.resolveExternal();
+  }
+  if (VELOCYPACK_UNLIKELY(!slice.isObject())) {
+    throw Exception(Exception::InvalidValueType, "Expecting Object");
+  }
+  for (auto it = _steps.begin(); it != _steps.end(); ++it) {
+    slice = lookup(*it, slice);
+    if (slice.isExternal()) {
+      slice = slice.resolveExternal();
+    }
+    // abort as early as possible
+    if (slice.isNone() || (it + 1 != _steps.end() && !slice.isObject())) {
+      return Slice();
+    }
+  }
+  return slice;
+}
+
+Slice CompiledPath::lookup(Step& step, Slice object) {
+  auto const h = object.head();
+  if (h < 0x0b || h > 0x0e) {
+    // empty or compact Object, without index table
+    return object.get(step.name);
+  }
+
+  uint8_t const* start = object.start();
+  ValueLength const offsetSize = ValueLength(1) << (h - 0x0b);
+  ValueLength const end = readIntegerNonEmpty<ValueLength>(start + 1, offsetSize);
+  ValueLength n;
+  ValueLength ieBase;
+  if (offsetSize < 8) {
+    n = readIntegerNonEmpty<ValueLength>(start + 1 + offsetSize, offsetSize);
+    ieBase = end - n * offsetSize;
+  } else {
+    n = readIntegerNonEmpty<ValueLength>(start + end - offsetSize, offsetSize);
+    ieBase = end - n * offsetSize - offsetSize;
+  }
+  if (n == 1) {
+    // just one attribute, there is no index table
+    return object.get(step.name);
+  }
+
+  auto keyAt = [&](ValueLength index) {
+    return Slice(start + readIntegerNonEmpty<ValueLength>(
+                             start + ieBase + index * offsetSize, offsetSize));
+  };
+
+  if (step.index < n) {
+    Slice key = keyAt(step.index);
+    if (isKey(key, step.name)) {
+      ++_hits;
+      return Slice(key.start() + key.byteSize());
+    }
+  }
+
+  ++_misses;
+  // the index table is sorted
+  ValueLength l = 0;
+  ValueLength r = n;
+  while (l < r) {
+    ValueLength index = l + (r - l) / 2;
+    Slice key = keyAt(index);
+    int res = key.makeKey().compareString(step.name);
+    if (res == 0) {
+      step.index = index;
+      return Slice(key.start() + key.byteSize());
+    }
+    if (res < 0) {
+      l = index + 1;
+    } else {
+      r = index;
+    }
+  }
+  return Slice();
+}
@@ -0,0 +1,480 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/IncrementalParser.h"
+#include "velocypack/Exception.h"
+#include "asm-functions.h"
+
+using namespace arangodb::velocypack;
+
+namespace {
+
+inline bool isWhiteSpace(uint8_t c) noexcept {
+  return (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+}
+
+// returns true for all bytes that cannot be part of a number or literal
+inline bool isDelimiter(uint8_t c) noexcept {
+  switch (c) {
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+    case ',':
+    case ':':
+    case '[':
+    case ']':
+    case '{':
+    case '}':
+    case '"':
+      return true;
+    default:
+      return false;
+  }
+}
+
+// returns the position of the closing quote of a string in data[pos, size),
+// or size if the string does not end there. escaped tells whether
+// data[pos] is escaped by a preceding backslash, and is updated for the
+// byte following the range if the string does not end in it
+std::size_t findStringEnd(uint8_t const* data, std::size_t pos,
+                          std::size_t size, bool& escaped) noexcept {
+  while (true) {
+    auto const* quote =
+        static_cast<uint8_t const*>(memchr(data + pos, '"', size - pos));
+    std::size_t const end = (quote == nullptr) ? size : quote - data;
+
+    // a quote is escaped if it follows an odd number of backslashes
+    std::size_t p = end;
+    while (p > pos && data[p - 1] == '\\') {
+      --p;
+    }
+    bool odd = ((end - p) & 1) != 0;
+    if (p == pos && escaped) {
+      odd = !odd;
+    }
+    if (quote == nullptr) {
+      escaped = odd;
+      return size;
+    }
+    if (!odd) {
+      escaped = false;
+      return end;
+    }
+    pos = end + 1;
+    escaped = false;
+  }
+}
+
+// returns the position of the last quote in data[0, size) that is not
+// escaped by a backslash within the range, or size if there is none
+std::size_t findLastQuote(uint8_t const* data, std::size_t size) noexcept {
+  std::size_t end = size;
+  while (end > 0) {
+    --end;
+    if (data[end] != '"') {
+      continue;
+    }
+    std::size_t p = end;
+    while (p > 0 && data[p - 1] == '\\') {
+      --p;
+    }
+    if (p > 0 && ((end - p) & 1) == 0) {
+      return end;
+    }
+  }
+  return size;
+}
+
+}  // namespace
+
+void IncrementalParser::reset() noexcept {
+  _stack.clear();
+  _pending.clear();
+  _offset = 0;
+  _errorPos = 0;
+  _keyPos = 0;
+  _lastQuote = 0;
+  _state = State::Value;
+  _pendingType = Pending::None;
+  _escaped = false;
+  _haveReported = false;
+  _started = false;
+}
+
+bool IncrementalParser::feed(uint8_t const* data, std::size_t size) {
+  std::size_t pos = 0;
+  try {
+    start();
+
+    if (_offset == 0 && size >= 3 && data[0] == 0xef && data[1] == 0xbb &&
+        data[2] == 0xbf) {
+      // skip over UTF-8 BOM at the start of the input
+      pos = 3;
+    }
+
+    if (_pendingType != Pending::None) {
+      resumePending(data, size, pos);
+    }
+
+    // strings that start before this quote are known to end inside
+    // this chunk
+    _lastQuote = findLastQuote(data, size);
+
+    while (pos < size) {
+      if (isWhiteSpace(data[pos])) {
+        std::size_t const remaining = size - pos;
+        if (remaining >= 16) {
+          pos += JSONSkipWhiteSpace(data + pos, remaining - 15);
+        }
+        while (pos < size && isWhiteSpace(data[pos])) {
+          ++pos;
+        }
+        continue;
+      }
+      handle(data, size, pos);
+    }
+  } catch (...) {
+    _errorPos = _offset + pos;
+    if (_haveReported) {
+      _parser._builderPtr->cleanupAdd();
+      _haveReported = false;
+    }
+    throw;
+  }
+
+  _offset += size;
+  return isComplete();
+}
+
+void IncrementalParser::finish() {
+  try {
+    start();
+
+    if (_pendingType == Pending::Scalar) {
+      _pendingType = Pending::None;
+      std::size_t const end =
+          parseScalar(reinterpret_cast<uint8_t const*>(_pending.data()),
+                      _pending.size(), 0);
+      endValue();
+      if (end != _pending.size()) {
+        throwUnexpected();
+      }
+    } else if (_pendingType != Pending::None) {
+      throw Exception(Exception::ParseError, "Unfinished string");
+    }
+    if (_state != State::Done) {
+      throwUnexpected();
+    }
+  } catch (...) {
+    _errorPos = _offset;
+    if (_haveReported) {
+      _parser._builderPtr->cleanupAdd();
+      _haveReported = false;
+    }
+    throw;
+  }
+}
+
+void IncrementalParser::start() {
+  if (!_started) {
+    if (options->clearBuilderBeforeParse) {
+      _parser._builderPtr->clear();
+    }
+    _started = true;
+  }
+}
+
+void IncrementalParser::handle(uint8_t const* data, std::size_t size,
+                               std::size_t& pos) {
+  uint8_t const c = data[pos];
+  Builder* builder = _parser._builderPtr;
+
+  switch (_state) {
+    case State::Value:
+      beginValue(data, size, pos);
+      return;
+    case State::ArrayFirst:
+      if (c == ']') {
+        ++pos;
+        closeCompound();
+        return;
+      }
+      builder->reportAdd();
+      beginValue(data, size, pos);
+      return;
+    case State::ArrayNext:
+      if (c == ',') {
+        ++pos;
+        builder->reportAdd();
+        _state = State::Value;
+        return;
+      }
+      if (c == ']') {
+        ++pos;
+        closeCompound();
+        return;
+      }
+      break;
+    case State::ObjectFirst:
+      if (c == '}') {
+        ++pos;
+        closeCompound();
+        return;
+      }
+      [[fallthrough]];
+    case State::ObjectKey:
+      if (c == '"') {
+        builder->reportAdd();
+        _keyPos = builder->_pos;
+        scanString(data, size, pos, true);
+        return;
+      }
+      break;
+    case State::ObjectColon:
+      if (c == ':') {
+        ++pos;
+        _state = State::Value;
+        return;
+      }
+      break;
+    case State::ObjectNext:
+      if (c == ',') {
+        ++pos;
+        _state = State::ObjectKey;
+        return;
+      }
+      if (c == '}') {
+        ++pos;
+        closeCompound();
+        return;
+      }
+      break;
+    case State::Done:
+      break;
+  }
+  throwUnexpected();
+}
+
+void IncrementalParser::beginValue(uint8_t const* data, std::size_t size,
+                                   std::size_t& pos) {
+  if (_stack.empty()) {
+    _haveReported = _parser.reportTopLevelValue();
+  }
+
+  switch (data[pos]) {
+    case '{':
+    case '[': {
+      bool const isObject = (data[pos] == '{');
+      ++pos;
+      if (isObject) {
+        _parser._builderPtr->addObject();
+      } else {
+        _parser._builderPtr->addArray();
+      }
+      if (_stack.size() + 1 >= options->nestingLimit) {
+        throw Exception(Exception::TooDeepNesting);
+      }
+      _stack.push_back(isObject);
+      _state = isObject ? State::ObjectFirst : State::ArrayFirst;
+      return;
+    }
+    case '"':
+      scanString(data, size, pos, false);
+      return;
+    case ',':
+    case ':':
+    case ']':
+    case '}':
+      throwUnexpected();
+      return;
+    default:
+      scanScalar(data, size, pos);
+      return;
+  }
+}
+
+void IncrementalParser::endValue() {
+  if (_stack.empty()) {
+    _state = State::Done;
+    _haveReported = false;
+  } else {
+    _state = _stack.back() ? State::ObjectNext : State::ArrayNext;
+  }
+}
+
+void IncrementalParser::closeCompound() {
+  VELOCYPACK_ASSERT(!_stack.empty());
+  // same as in Parser: only a non-empty top-level object is kept open
+  if (!_stack.back() || _state == State::ObjectFirst || _stack.size() != 1 ||
+      !options->keepTopLevelOpen) {
+    _parser._builderPtr->close();
+  }
+  _stack.pop_back();
+  endValue();
+}
+
+void IncrementalParser::scanString(uint8_t const* data, std::size_t size,
+                                   std::size_t& pos, bool isKey) {
+  if (pos < _lastQuote && _lastQuote < size) {
+    parseString(data, size, pos + 1, isKey);
+    pos = _parser._pos;
+    return;
+  }
+
+  bool escaped = false;
+  std::size_t const end = findStringEnd(data, pos + 1, size, escaped);
+  if (end < size) {
+    parseString(data, end + 1, pos + 1, isKey);
+    pos = end + 1;
+    return;
+  }
+
+  // string continues in the next chunk
+  _pending.assign(reinterpret_cast<char const*>(data) + pos, size - pos);
+  _pendingType = isKey ? Pending::Key : Pending::String;
+  _escaped = escaped;
+  pos = size;
+}
+
+void IncrementalParser::scanScalar(uint8_t const* data, std::size_t size,
+                                   std::size_t& pos) {
+  std::size_t end = pos;
+  while (end < size && !isDelimiter(data[end])) {
+    ++end;
+  }
+  if (end < size) {
+    // bytes up to end that do not belong to the value are handled as
+    // unexpected input by the caller
+    pos = parseScalar(data, end, pos);
+    endValue();
+    return;
+  }
+
+  // the value may continue in the next chunk
+  _pending.assign(reinterpret_cast<char const*>(data) + pos, size - pos);
+  _pendingType = Pending::Scalar;
+  pos = size;
+}
+
+void IncrementalParser::resumePending(uint8_t const* data, std::size_t size,
+                                      std::size_t& pos) {
+  if (_pendingType == Pending::Scalar) {
+    std::size_t end = 0;
+    while (end < size && !isDelimiter(data[end])) {
+      ++end;
+    }
+    _pending.append(reinterpret_cast<char const*>(data), end);
+    pos = end;
+    if (end == size) {
+      return;
+    }
+    _pendingType = Pending::None;
+    end = parseScalar(reinterpret_cast<uint8_t const*>(_pending.data()),
+                      _pending.size(), 0);
+    endValue();
+    if (end != _pending.size()) {
+      throwUnexpected();
+    }
+    return;
+  }
+
+  std::size_t const end = findStringEnd(data, 0, size, _escaped);
+  if (end == size) {
+    _pending.append(reinterpret_cast<char const*>(data), size);
+    pos = size;
+    return;
+  }
+  _pending.append(reinterpret_cast<char const*>(data), end + 1);
+  bool const isKey = (_pendingType == Pending::Key);
+  _pendingType = Pending::None;
+  // the pending string still has its opening quote
+  parseString(reinterpret_cast<uint8_t const*>(_pending.data()),
+              _pending.size(), 1, isKey);
+  pos = end + 1;
+}
+
+void IncrementalParser::parseString(uint8_t const* data, std::size_t size,
+                                    std::size_t pos, bool isKey) {
+  _parser._start = data;
+  _parser._size = size;
+  _parser._pos = pos;
+  _parser.parseString();
+
+  if (isKey) {
+    if (options->attributeTranslator != nullptr) {
+      _parser.translateAttributeName(_keyPos);
+    }
+    _state = State::ObjectColon;
+  } else {
+    endValue();
+  }
+}
+
+std::size_t IncrementalParser::parseScalar(uint8_t const* data,
+                                           std::size_t end, std::size_t pos) {
+  _parser._start = data;
+  _parser._size = end;
+  _parser._pos = pos + 1;
+  switch (data[pos]) {
+    case 't':
+      _parser.parseTrue();
+      break;
+    case 'f':
+      _parser.parseFalse();
+      break;
+    case 'n':
+      _parser.parseNull();
+      break;
+    default:
+      _parser._pos = pos;
+      _parser.parseNumber();
+      break;
+  }
+  return _parser._pos;
+}
+
+void IncrementalParser::throwUnexpected() const {
+  switch (_state) {
+    case State::Value:
+      throw Exception(Exception::ParseError, "Expecting item");
+    case State::ArrayFirst:
+      throw Exception(Exception::ParseError, "Expecting item or ']'");
+    case State::ArrayNext:
+      throw Exception(Exception::ParseError, "Expecting ',' or ']'");
+    case State::ObjectFirst:
+    case State::ObjectKey:
+      throw Exception(Exception::ParseError, "Expecting '\"' or '}'");
+    case State::ObjectColon:
+      throw Exception(Exception::ParseError, "Expecting ':'");
+    case State::ObjectNext:
+      throw Exception(Exception::ParseError, "Expecting ',' or '}'");
+    case State::Done:
+      break;
+  }
+  throw Exception(Exception::ParseError, "Expecting EOF");
+}
@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <limits>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/Exception.h"
+#include "velocypack/Iterator.h"
+#include "velocypack/ObjectIndex.h"
+
+using namespace arangodb::velocypack;
+
+ObjectIndex::ObjectIndex(Slice object) : _object(object), _size(0) {
+  build();
+}
+
+ObjectIndex::ObjectIndex(SharedSlice object)
+    : _owner(std::move(object)), _object(_owner.slice()), _size(0) {
+  build();
+}
+
+void ObjectIndex::build() {
+  if (VELOCYPACK_UNLIKELY(!_object.isObject())) {
+    throw Exception(Exception::InvalidValueType, "Expecting Object");
+  }
+  if (VELOCYPACK_UNLIKELY(_object.byteSize() >
+                          std::numeric_limits<uint32_t>::max())) {
+    throw Exception(Exception::IndexOutOfBounds,
+                    "Object too large for ObjectIndex");
+  }
+
+  // at most half of the slots are used, so that probe sequences are short
+  ValueLength const n = _object.length();
+  std::size_t capacity = 8;
+  while (capacity < 2 * n) {
+    capacity *= 2;
+  }
+  _slots.assign(capacity, Slot{0, 0, 0});
+  std::size_t const mask = capacity - 1;
+
+  uint8_t const* base = _object.start();
+  ObjectIterator it(_object, /*useSequentialIteration*/ true);
+  while (it.valid()) {
+    Slice key = it.key(/*translate*/ false);
+    HashedStringRef name(key.makeKey());
+    std::size_t i = name.hash() & mask;
+    while (true) {
+      Slot& slot = _slots[i];
+      if (slot.valueOffset == 0) {
+        slot.tag = name.tag();
+        slot.keyOffset = static_cast<uint32_t>(key.start() - base);
+        slot.valueOffset =
+            static_cast<uint32_t>(key.start() + key.byteSize() - base);
+        ++_size;
+        break;
+      }
+      if (slot.tag == name.tag() && matches(slot, name.stringView())) {
+        // keep the first of duplicate names
+        break;
+      }
+      i = (i + 1) & mask;
+    }
+    it.next();
+  }
+}
@@ -0,0 +1,143 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <numeric>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/Exception.h"
+#include "velocypack/OffsetCache.h"
+
+using namespace arangodb::velocypack;
+
+OffsetCache::OffsetCache(Slice slice) : _slice(slice) { init(); }
+
+OffsetCache::OffsetCache(SharedSlice slice)
+    : _owner(std::move(slice)), _slice(_owner.slice()) {
+  init();
+}
+
+void OffsetCache::init() {
+  if (VELOCYPACK_UNLIKELY(!_slice.isArray() && !_slice.isObject())) {
+    throw Exception(Exception::InvalidValueType,
+                    "Expecting type Array or Object");
+  }
+  _length = _slice.length();
+  auto const h = _slice.head();
+  _compact = (h == 0x13 || h == 0x14);
+  _next = 0;
+  if (_compact) {
+    _offsets.reserve(_length);
+    _next = 1 + getVariableValueLength(
+                    readVariableValueLength<false>(_slice.start() + 1));
+  }
+}
+
+ValueLength OffsetCache::offsetOf(ValueLength index) {
+  VELOCYPACK_ASSERT(_compact);
+  if (VELOCYPACK_UNLIKELY(index >= _length)) {
+    throw Exception(Exception::IndexOutOfBounds);
+  }
+  bool const isObject = (_slice.head() == 0x14);
+  uint8_t const* start = _slice.start();
+  while (_offsets.size() <= index) {
+    _offsets.push_back(_next);
+    _next += Slice(start + _next).byteSize();
+    if (isObject) {
+      _next += Slice(start + _next).byteSize();
+    }
+  }
+  return _offsets[index];
+}
+
+Slice OffsetCache::at(ValueLength index) {
+  if (VELOCYPACK_UNLIKELY(!_slice.isArray())) {
+    throw Exception(Exception::InvalidValueType, "Expecting type Array");
+  }
+  if (!_compact) {
+    return _slice.at(index);
+  }
+  return Slice(_slice.start() + offsetOf(index));
+}
+
+Slice OffsetCache::keyAt(ValueLength index, bool translate) {
+  if (VELOCYPACK_UNLIKELY(!_slice.isObject())) {
+    throw Exception(Exception::InvalidValueType, "Expecting type Object");
+  }
+  if (!_compact) {
+    return _slice.keyAt(index, translate);
+  }
+  Slice key(_slice.start() + offsetOf(index));
+  return translate ? key.makeKey() : key;
+}
+
+Slice OffsetCache::valueAt(ValueLength index) {
+  if (VELOCYPACK_UNLIKELY(!_slice.isObject())) {
+    throw Exception(Exception::InvalidValueType, "Expecting type Object");
+  }
+  if (!_compact) {
+    return _slice.valueAt(index);
+  }
+  Slice key(_slice.start() + offsetOf(index));
+  return Slice(key.start() + key.byteSize());
+}
+
+Slice OffsetCache::get(std::string_view attribute) {
+  if (!_compact) {
+    return _slice.get(attribute);
+  }
+  if (VELOCYPACK_UNLIKELY(!_slice.isObject())) {
+    throw Exception(Exception::InvalidValueType, "Expecting Object");
+  }
+
+  uint8_t const* start = _slice.start();
+  auto keyOf = [&](ValueLength index) {
+    return Slice(start + _offsets[index]).makeKey().stringView();
+  };
+
+  if (_sorted.size() != _length) {
+    if (_length == 0) {
+      return Slice();
+    }
+    offsetOf(_length - 1);
+    _sorted.resize(_length);
+    std::iota(_sorted.begin(), _sorted.end(), ValueLength(0));
+    // stable, so that the first of duplicate keys is found, as by
+    // Slice::get()
+    std::stable_sort(_sorted.begin(), _sorted.end(),
+                     [&](ValueLength a, ValueLength b) {
+                       return keyOf(a) < keyOf(b);
+                     });
+  }
+
+  auto it = std::lower_bound(
+      _sorted.begin(), _sorted.end(), attribute,
+      [&](ValueLength a, std::string_view b) { return keyOf(a) < b; });
+  if (it == _sorted.end() || keyOf(*it) != attribute) {
+    return Slice();
+  }
+  Slice key(start + _offsets[*it]);
+  return Slice(key.start() + key.byteSize());
+}
@@ -23,15 +23,362 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "velocypack/velocypack-common.h"
+#include "velocypack/AttributeProjection.h"
 #include "velocypack/Parser.h"
 #include "velocypack/Value.h"
 #include "velocypack/ValueType.h"
 #include "asm-functions.h"
+#include "fast-float.h"
 
-#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <thread>
 
 using namespace arangodb::velocypack;
 
+namespace {
+
+// mantissa values below this threshold can take 8 more decimal digits
+// without any risk of overflowing
+constexpr uint64_t maxValueForEightDigits = 100000000000ULL;  // 10^11
+
+// returns the number of leading ASCII digits ('0' to '9') in the 8 bytes
+// of chunk (which must have been loaded in little endian order)
+inline std::size_t countLeadingDigits(uint64_t chunk) noexcept {
+  // a byte is a digit if adding 0x46 does not set its high bit (byte is
+  // < 0x3a) and subtracting 0x30 does not set its high bit (byte is >= 0x30)
+  uint64_t const nonDigits =
+      ((chunk + 0x4646464646464646ULL) | (chunk - 0x3030303030303030ULL)) &
+      0x8080808080808080ULL;
+  if (nonDigits == 0) {
+    return 8;
+  }
+  return static_cast<std::size_t>(std::countr_zero(nonDigits)) / 8;
+}
+
+// converts 8 ASCII digits (loaded in little endian order) into their
+// integer value, using SWAR multiply-add steps
+inline uint64_t parseEightDigits(uint64_t chunk) noexcept {
+  chunk -= 0x3030303030303030ULL;
+  // combine pairs of adjacent digits
+  chunk = (chunk * 10) + (chunk >> 8);
+  // combine pairs of 2-digit values, then the two 4-digit values
+  uint64_t const mask = 0x000000ff000000ffULL;
+  uint64_t const mul1 = 0x000f424000000064ULL;  // 100 + (1000000 << 32)
+  uint64_t const mul2 = 0x0000271000000001ULL;  // 1 + (10000 << 32)
+  return (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+}
+
+// converts the first n (1 <= n <= 8) ASCII digits of chunk into their
+// integer value
+inline uint64_t parseLeadingDigits(uint64_t chunk, std::size_t n) noexcept {
+  VELOCYPACK_ASSERT(n >= 1 && n <= 8);
+  if (n < 8) {
+    // shift the digits to the most significant positions and fill up
+    // the low bytes with '0' characters
+    chunk = (chunk << (8 * (8 - n))) | (0x3030303030303030ULL >> (8 * n));
+  }
+  return parseEightDigits(chunk);
+}
+
+// number of lines a thread in Parser::fromNdjson() claims at a time
+constexpr std::size_t ndjsonBatchSize = 64;
+
+// minimum size of the JSON input for parsing a top-level array in parallel
+constexpr std::size_t parallelArrayMinSize = 1024 * 1024;
+
+// minimum size of the chunks of array members parsed by one thread
+constexpr std::size_t parallelArrayMinChunkSize = 16 * 1024;
+
+constexpr uint64_t powersOfTen[] = {1ULL,      10ULL,      100ULL,
+                                    1000ULL,   10000ULL,   100000ULL,
+                                    1000000ULL, 10000000ULL, 100000000ULL};
+
+// returns the bits of all characters escaped by a backslash. prevEscaped
+// carries the escape state of the last bit over to the next block
+inline uint64_t findEscaped(uint64_t backslash,
+                            uint64_t& prevEscaped) noexcept {
+  constexpr uint64_t evenBits = 0x5555555555555555ULL;
+
+  // a backslash that is itself escaped does not start an escape
+  backslash &= ~prevEscaped;
+  uint64_t const followsEscape = (backslash << 1) | prevEscaped;
+  // backslash sequences that start on an odd bit
+  uint64_t const oddStarts = backslash & ~evenBits & ~followsEscape;
+  // adding the sequence starts to the backslashes carries through each
+  // sequence of consecutive backslashes, so the bit behind each sequence
+  // tells whether it had an odd or an even length
+  uint64_t const evenStarts = oddStarts + backslash;
+  prevEscaped = (evenStarts < oddStarts) ? 1 : 0;
+  uint64_t const invertMask = evenStarts << 1;
+  return (evenBits ^ invertMask) & followsEscape;
+}
+
+// sets each bit to the xor of itself and all lower bits, turning a mask
+// of quotes into a mask of the bytes between them
+inline uint64_t prefixXor(uint64_t bits) noexcept {
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+// classifies the input in consecutive blocks of 64 bytes, one bit per
+// byte, and keeps track of escape sequences and strings across the
+// block boundaries
+class BlockScanner {
+ public:
+  // classifies the 64 bytes at data[pos], padded with whitespace if the
+  // input ends before
+  void next(uint8_t const* data, std::size_t pos, std::size_t size) noexcept {
+    if (size - pos >= 64) {
+      JSONClassifyBlock(data + pos, masks);
+    } else {
+      uint8_t block[64];
+      memset(&block[0], ' ', sizeof(block));
+      memcpy(&block[0], data + pos, size - pos);
+      JSONClassifyBlock(&block[0], masks);
+    }
+
+    uint64_t const escaped = findEscaped(masks.backslash, _prevEscaped);
+    quote = masks.quote & ~escaped;
+    inString = prefixXor(quote) ^ _prevInString;
+    _prevInString =
+        static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+  }
+
+  JSONBlockMasks masks;
+  // unescaped quotes
+  uint64_t quote = 0;
+  // bytes inside strings, including the opening but not the closing quote
+  uint64_t inString = 0;
+
+ private:
+  uint64_t _prevEscaped = 0;
+  uint64_t _prevInString = 0;
+};
+
+// first pass of parsing with a structural index: finds the positions
+// of all structural characters, of all unescaped quotes, of the first
+// characters of all other values, and of all backslashes and control
+// characters inside strings in data[pos, size)
+void buildStructuralIndex(uint8_t const* data, std::size_t pos,
+                          std::size_t size, std::vector<uint32_t>& index) {
+  std::size_t count = 0;
+  uint64_t prevScalar = 0;
+  BlockScanner scanner;
+
+  while (pos < size) {
+    scanner.next(data, pos, size);
+    JSONBlockMasks const& masks = scanner.masks;
+
+    // first bytes of numbers, true, false, null and invalid tokens
+    uint64_t const scalar =
+        ~(masks.structural | masks.whitespace | scanner.quote);
+    uint64_t const scalarStart = scalar & ~((scalar << 1) | prevScalar);
+    prevScalar = scalar >> 63;
+
+    uint64_t bits = scanner.quote |
+                    ((masks.structural | scalarStart) & ~scanner.inString) |
+                    ((masks.backslash | masks.control) & scanner.inString);
+
+    if (index.size() - count < 64) {
+      index.resize(std::max<std::size_t>(2 * index.size(), 1024));
+    }
+    uint32_t* out = index.data() + count;
+    count += static_cast<std::size_t>(std::popcount(bits));
+    while (bits != 0) {
+      *out++ = static_cast<uint32_t>(pos + std::countr_zero(bits));
+      bits &= bits - 1;
+    }
+    pos += 64;
+  }
+  index.resize(count);
+}
+
+// returns the number of threads to use for a concurrency setting,
+// where 0 means one thread per hardware thread
+std::size_t threadCount(std::size_t concurrency) noexcept {
+  if (concurrency == 0) {
+    concurrency = std::thread::hardware_concurrency();
+  }
+  return std::max<std::size_t>(concurrency, 1);
+}
+
+// runs work on the calling thread and on concurrency - 1 extra threads,
+// and waits until all of them are done
+template<typename F>
+void runParallel(std::size_t concurrency, F const& work) {
+  std::vector<std::thread> threads;
+  if (concurrency > 1) {
+    threads.reserve(concurrency - 1);
+    for (std::size_t i = 1; i < concurrency; ++i) {
+      threads.emplace_back(work);
+    }
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// finds the end of the array whose members start at data[pos], and
+// splits the members into chunks of roughly chunkSize bytes. the
+// positions of the commas between the chunks are appended to splits.
+// returns the position of the closing ']', or size if there is none.
+// invalid JSON is not detected here, but when parsing the chunks
+std::size_t splitArray(uint8_t const* data, std::size_t pos, std::size_t size,
+                       std::size_t chunkSize, std::vector<std::size_t>& splits) {
+  std::size_t depth = 1;
+  std::size_t chunkStart = pos;
+  BlockScanner scanner;
+
+  while (pos < size) {
+    scanner.next(data, pos, size);
+    uint64_t bits = scanner.masks.structural & ~scanner.inString;
+    while (bits != 0) {
+      std::size_t const p = pos + std::countr_zero(bits);
+      bits &= bits - 1;
+      switch (data[p]) {
+        case '[':
+        case '{':
+          ++depth;
+          break;
+        case ']':
+        case '}':
+          if (--depth == 0) {
+            return p;
+          }
+          break;
+        case ',':
+          if (depth == 1 && p - chunkStart >= chunkSize) {
+            splits.push_back(p);
+            chunkStart = p;
+          }
+          break;
+        default:
+          break;
+      }
+    }
+    pos += 64;
+  }
+  return size;
+}
+
+// returns the position of the closing bracket of the array or object
+// whose contents start at data[pos], or size if there is none. the
+// brackets in between are counted, but not matched against each other
+std::size_t findCompoundEnd(uint8_t const* data, std::size_t pos,
+                            std::size_t size) noexcept {
+  std::size_t depth = 1;
+  BlockScanner scanner;
+
+  while (pos < size) {
+    scanner.next(data, pos, size);
+    uint64_t bits = scanner.masks.structural & ~scanner.inString;
+    while (bits != 0) {
+      std::size_t const p = pos + std::countr_zero(bits);
+      bits &= bits - 1;
+      switch (data[p]) {
+        case '[':
+        case '{':
+          ++depth;
+          break;
+        case ']':
+        case '}':
+          if (--depth == 0) {
+            return p;
+          }
+          break;
+        default:
+          break;
+      }
+    }
+    pos += 64;
+  }
+  return size;
+}
+
+}  // namespace
+
+std::vector<SharedSlice> Parser::fromNdjson(std::string_view ndjson,
+                                            Options const* options,
+                                            std::size_t concurrency) {
+  if (VELOCYPACK_UNLIKELY(options == nullptr)) {
+    throw Exception(Exception::InternalError, "Options cannot be a nullptr");
+  }
+
+  // JSON values cannot contain raw newlines, so each newline ends a value
+  std::vector<std::string_view> lines;
+  while (!ndjson.empty()) {
+    std::size_t end = ndjson.find('\n');
+    if (end == std::string_view::npos) {
+      end = ndjson.size();
+    }
+    std::string_view line = ndjson.substr(0, end);
+    if (line.find_first_not_of(" \t\r") != std::string_view::npos) {
+      lines.push_back(line);
+    }
+    ndjson.remove_prefix(std::min(end + 1, ndjson.size()));
+  }
+
+  std::vector<SharedSlice> result(lines.size());
+
+  // lines are handed out to the threads in batches, in input order. after
+  // a failure, only batches in front of the failing line are processed
+  // further, so that the error of the first invalid line is reported
+  std::atomic<std::size_t> next{0};
+  std::atomic<std::size_t> errorLine{lines.size()};
+  std::exception_ptr error;
+  std::mutex errorMutex;
+
+  auto work = [&]() {
+    Builder builder(options);
+    Parser parser(builder, options);
+    while (true) {
+      std::size_t const first = next.fetch_add(::ndjsonBatchSize);
+      if (first >= errorLine.load()) {
+        return;
+      }
+      std::size_t const last =
+          std::min(first + ::ndjsonBatchSize, errorLine.load());
+      for (std::size_t i = first; i < last; ++i) {
+        try {
+          builder.clear();
+          parser.parse(lines[i]);
+          result[i] = builder.sharedSlice();
+        } catch (...) {
+          std::lock_guard<std::mutex> guard(errorMutex);
+          if (i < errorLine.load()) {
+            errorLine.store(i);
+            error = std::current_exception();
+          }
+          return;
+        }
+      }
+    }
+  };
+
+  ::runParallel(std::min(::threadCount(concurrency),
+                         (lines.size() + ::ndjsonBatchSize - 1) /
+                             ::ndjsonBatchSize),
+                work);
+
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+  return result;
+}
+
 // The following function does the actual parse. It gets bytes
 // via peek, consume and reset appends the result to the Builder
 // in *_builderPtr. Errors are reported via an exception.
@@ -47,25 +394,50 @@ ValueLength Parser::parseInternal(bool multi) {
     _pos += 3;
   }
 
+  AttributeProjection const* projection = options->projection;
+
+  // a large top-level array is parsed in parallel, without the structural
+  // index
+  bool parallel = projection == nullptr && !multi &&
+                  options->parallelArrayThreads != 1 &&
+                  _size - _pos >= ::parallelArrayMinSize;
+  if (parallel) {
+    std::size_t p = _pos;
+    while (p < _size && isWhiteSpace(_start[p])) {
+      ++p;
+    }
+    parallel = (p < _size && _start[p] == '[');
+  }
+
+  bool const indexed = projection == nullptr && !parallel &&
+                       options->useStructuralIndex &&
+                       _size <= std::numeric_limits<uint32_t>::max();
+  if (indexed) {
+    ::buildStructuralIndex(_start, _pos, _size, _structurals);
+    _structuralPos = 0;
+  }
+
+  // options may have changed since the last parse, so do not predict
+  // attribute names from it
+  for (auto& shape : _keyShapes) {
+    shape->truncate(0);
+  }
+
   ValueLength nr = 0;
   do {
-    bool haveReported = false;
-    if (!_builderPtr->_stack.empty()) {
-      ValueLength const tos = _builderPtr->_stack.back().startPos;
-      if (_builderPtr->_start[tos] == 0x0b ||
-          _builderPtr->_start[tos] == 0x14) {
-        if (!_builderPtr->_keyWritten) {
-          throw Exception(Exception::BuilderKeyMustBeString);
-        } else {
-          _builderPtr->_keyWritten = false;
-        }
+    bool const haveReported = reportTopLevelValue();
+    try {
+      if (projection != nullptr) {
+        parseJsonProjected(*projection);
+      } else if (parallel) {
+        skipWhiteSpace("Expecting item");
+        ++_pos;
+        parseArrayParallel();
+      } else if (indexed) {
+        parseJsonIndexed();
       } else {
-        _builderPtr->reportAdd();
-        haveReported = true;
+        parseJson();
       }
-    }
-    try {
-      parseJson();
     } catch (...) {
       if (haveReported) {
         _builderPtr->cleanupAdd();
@@ -73,6 +445,15 @@ ValueLength Parser::parseInternal(bool multi) {
       throw;
     }
     nr++;
+    if (indexed) {
+      if (_structuralPos == _structurals.size()) {
+        _pos = _size;
+      } else if (!multi) {
+        nextStructural("");  // to get error reporting right
+        throw Exception(Exception::ParseError, "Expecting EOF");
+      }
+      continue;
+    }
     while (_pos < _size && isWhiteSpace(_start[_pos])) {
       ++_pos;
     }
@@ -85,6 +466,131 @@ ValueLength Parser::parseInternal(bool multi) {
   return nr;
 }
 
+// parses a top-level array by splitting its members into chunks and
+// parsing the chunks on multiple threads. the members of each chunk are
+// built as a sequence of values in a separate Builder, and are finally
+// copied into the array in our Builder, which then builds the index
+// table once when closing the array. the result is the same as with
+// parseArray()
+void Parser::parseArrayParallel() {
+  // we have seen the opening '['
+  std::size_t const begin = _pos;
+  std::size_t const concurrency = ::threadCount(options->parallelArrayThreads);
+  std::size_t const chunkSize = std::max<std::size_t>(
+      (_size - begin) / (4 * concurrency), ::parallelArrayMinChunkSize);
+
+  std::vector<std::size_t> splits;
+  std::size_t const end = ::splitArray(_start, begin, _size, chunkSize, splits);
+  if (end == _size || _start[end] != ']' || splits.empty()) {
+    // not worth it, or invalid. in the latter case, the regular parser
+    // reports the error
+    parseArray();
+    return;
+  }
+
+  std::size_t const numChunks = splits.size() + 1;
+  auto chunkBegin = [&](std::size_t i) {
+    return (i == 0) ? begin : splits[i - 1] + 1;
+  };
+  auto chunkEnd = [&](std::size_t i) {
+    return (i == splits.size()) ? end : splits[i];
+  };
+
+  // the members are built as by our Builder, and parsed as by us
+  Options builderOptions = *_builderPtr->options;
+  builderOptions.keepTopLevelOpen = false;
+  builderOptions.parallelArrayThreads = 1;
+  Options parserOptions = *options;
+  parserOptions.keepTopLevelOpen = false;
+  parserOptions.parallelArrayThreads = 1;
+
+  std::vector<std::unique_ptr<Builder>> chunks;
+  chunks.reserve(numChunks);
+  for (std::size_t i = 0; i < numChunks; ++i) {
+    chunks.emplace_back(std::make_unique<Builder>(&builderOptions));
+  }
+
+  std::atomic<std::size_t> next{0};
+  std::atomic<bool> failed{false};
+
+  auto work = [&]() {
+    while (!failed.load()) {
+      std::size_t const i = next.fetch_add(1);
+      if (i >= numChunks) {
+        return;
+      }
+      Parser parser(*chunks[i], &parserOptions);
+      parser._start = _start;
+      parser._size = chunkEnd(i);
+      parser._pos = chunkBegin(i);
+      // same nesting as for the members of our array
+      parser._nesting = _nesting + 1;
+      try {
+        while (true) {
+          parser.parseJson();
+          while (parser._pos < parser._size &&
+                 isWhiteSpace(_start[parser._pos])) {
+            ++parser._pos;
+          }
+          if (parser._pos == parser._size) {
+            break;
+          }
+          if (_start[parser._pos] != ',') {
+            throw Exception(Exception::ParseError, "Expecting ',' or ']'");
+          }
+          ++parser._pos;
+        }
+      } catch (...) {
+        failed.store(true);
+        return;
+      }
+    }
+  };
+
+  ::runParallel(std::min(concurrency, numChunks), work);
+
+  if (failed.load()) {
+    // let the regular parser report the first error
+    parseArray();
+    return;
+  }
+
+  _builderPtr->addArray();
+  increaseNesting();
+  for (auto const& chunk : chunks) {
+    ValueLength const size = chunk->_pos;
+    _builderPtr->reserve(size);
+    memcpy(_builderPtr->_start + _builderPtr->_pos, chunk->_start,
+           checkOverflow(size));
+    ValueLength offset = 0;
+    while (offset < size) {
+      ValueLength const length = Slice(chunk->_start + offset).byteSize();
+      _builderPtr->reportAdd();
+      _builderPtr->advance(length);
+      offset += length;
+    }
+  }
+  _builderPtr->close();
+  decreaseNesting();
+  _pos = end + 1;
+}
+
+bool Parser::reportTopLevelValue() {
+  if (!_builderPtr->_stack.empty()) {
+    ValueLength const tos = _builderPtr->_stack.back().startPos;
+    if (_builderPtr->_start[tos] == 0x0b || _builderPtr->_start[tos] == 0x14) {
+      if (!_builderPtr->_keyWritten) {
+        throw Exception(Exception::BuilderKeyMustBeString);
+      }
+      _builderPtr->_keyWritten = false;
+    } else {
+      _builderPtr->reportAdd();
+      return true;
+    }
+  }
+  return false;
+}
+
 // skips over all following whitespace tokens but does not consume the
 // byte following the whitespace
 int Parser::skipWhiteSpace(char const* err) {
@@ -120,6 +626,67 @@ int Parser::skipWhiteSpace(char const* err) {
   throw Exception(Exception::ParseError, err);
 }
 
+void Parser::scanDigits(ParsedNumber& value) {
+  // fast path: convert up to 8 digits at a time as long as the value
+  // cannot overflow
+  while (value.isInteger && value.intValue < ::maxValueForEightDigits &&
+         _size - _pos >= 8) {
+    uint64_t const chunk = readIntegerFixed<uint64_t, 8>(_start + _pos);
+    std::size_t const n = ::countLeadingDigits(chunk);
+    if (n == 0) {
+      return;
+    }
+    value.intValue = value.intValue * ::powersOfTen[n] +
+                     ::parseLeadingDigits(chunk, n);
+    _pos += n;
+    if (n < 8) {
+      return;
+    }
+  }
+
+  // slow path, close to the end of the input or close to 2^64
+  while (true) {
+    int i = consume();
+    if (i < 0) {
+      return;
+    }
+    if (i < '0' || i > '9') {
+      unconsume();
+      return;
+    }
+    value.addDigit(i);
+  }
+}
+
+void Parser::scanDigitsFractional(ParsedNumber& value) {
+  while (value.intValue < ::maxValueForEightDigits && _size - _pos >= 8) {
+    uint64_t const chunk = readIntegerFixed<uint64_t, 8>(_start + _pos);
+    std::size_t const n = ::countLeadingDigits(chunk);
+    if (n == 0) {
+      return;
+    }
+    value.intValue = value.intValue * ::powersOfTen[n] +
+                     ::parseLeadingDigits(chunk, n);
+    value.exponent10 -= static_cast<int64_t>(n);
+    _pos += n;
+    if (n < 8) {
+      return;
+    }
+  }
+
+  while (true) {
+    int i = consume();
+    if (i < 0) {
+      return;
+    }
+    if (i < '0' || i > '9') {
+      unconsume();
+      return;
+    }
+    value.addFractionalDigit(i);
+  }
+}
+
 void Parser::increaseNesting() {
   if (++_nesting >= options->nestingLimit) {
     throw Exception(Exception::TooDeepNesting);
@@ -131,6 +698,32 @@ void Parser::decreaseNesting() noexcept {
   --_nesting;
 }
 
+// adds a double value to the builder, converted from the decimal
+// representation in value
+void Parser::addDouble(ParsedNumber const& value, bool negative,
+                       std::size_t startPos) {
+  double result;
+  if (VELOCYPACK_UNLIKELY(!decimalToDouble(value.intValue, value.exponent10,
+                                           value.isTruncated, result))) {
+    // the fast algorithm could not produce a correctly rounded result.
+    // this is very rare and happens only for numbers with many digits
+    if (!parseDouble(reinterpret_cast<char const*>(_start) + startPos,
+                     reinterpret_cast<char const*>(_start) + _pos, result)) {
+      if (value.exponent10 >= -300) {
+        throw Exception(Exception::NumberOutOfRange);
+      }
+      // underflow
+      result = 0.0;
+    }
+    // the sign is part of the string
+    negative = false;
+  }
+  if (VELOCYPACK_UNLIKELY(!std::isfinite(result))) {
+    throw Exception(Exception::NumberOutOfRange);
+  }
+  _builderPtr->addDouble(negative ? -result : result);
+}
+
 // parses a number value
 void Parser::parseNumber() {
   std::size_t startPos = _pos;
@@ -157,11 +750,7 @@ void Parser::parseNumber() {
       unconsume();
     }
     if (!numberValue.isInteger) {
-      if (negative) {
-        _builderPtr->addDouble(-numberValue.doubleValue);
-      } else {
-        _builderPtr->addDouble(numberValue.doubleValue);
-      }
+      addDouble(numberValue, negative, startPos);
     } else if (negative) {
       if (numberValue.intValue <= static_cast<uint64_t>(INT64_MAX)) {
         _builderPtr->addInt(-static_cast<int64_t>(numberValue.intValue));
@@ -176,7 +765,6 @@ void Parser::parseNumber() {
     return;
   }
 
-  double fractionalPart;
   if (i == '.') {
     // fraction. skip over '.'
     i = getOneOrThrow("Incomplete number");
@@ -184,58 +772,41 @@ void Parser::parseNumber() {
       throw Exception(Exception::ParseError, "Incomplete number");
     }
     unconsume();
-    fractionalPart = scanDigitsFractional();
-    if (negative) {
-      fractionalPart = -numberValue.asDouble() - fractionalPart;
-    } else {
-      fractionalPart = numberValue.asDouble() + fractionalPart;
-    }
+    scanDigitsFractional(numberValue);
     i = consume();
     if (i < 0) {
-      _builderPtr->addDouble(fractionalPart);
+      addDouble(numberValue, negative, startPos);
       return;
     }
-  } else {
-    if (negative) {
-      fractionalPart = -numberValue.asDouble();
-    } else {
-      fractionalPart = numberValue.asDouble();
-    }
   }
   if (i != 'e' && i != 'E') {
     unconsume();
-    // use conventional atof() conversion here, to avoid precision loss
-    // when interpreting and multiplying the single digits of the input stream
-    // _builderPtr->addDouble(fractionalPart);
-    _builderPtr->addDouble(
-        atof(reinterpret_cast<char const*>(_start) + startPos));
+    addDouble(numberValue, negative, startPos);
     return;
   }
   i = getOneOrThrow("Incomplete number");
-  negative = false;
+  bool negativeExponent = false;
   if (i == '+' || i == '-') {
-    negative = (i == '-');
+    negativeExponent = (i == '-');
     i = getOneOrThrow("Incomplete number");
   }
   if (i < '0' || i > '9') {
     throw Exception(Exception::ParseError, "Incomplete number");
   }
-  unconsume();
-  ParsedNumber exponent;
-  scanDigits(exponent);
-  if (negative) {
-    fractionalPart *= pow(10, -exponent.asDouble());
-  } else {
-    fractionalPart *= pow(10, exponent.asDouble());
-  }
-  if (std::isnan(fractionalPart) || !std::isfinite(fractionalPart)) {
-    throw Exception(Exception::NumberOutOfRange);
+  int64_t exponent = 0;
+  do {
+    // saturate the exponent. everything beyond this is out of range
+    // for a double anyway
+    if (exponent < 100000) {
+      exponent = exponent * 10 + (i - '0');
+    }
+    i = consume();
+  } while (i >= '0' && i <= '9');
+  if (i >= 0) {
+    unconsume();
   }
-  // use conventional atof() conversion here, to avoid precision loss
-  // when interpreting and multiplying the single digits of the input stream
-  // _builderPtr->addDouble(fractionalPart);
-  _builderPtr->addDouble(
-      atof(reinterpret_cast<char const*>(_start) + startPos));
+  numberValue.exponent10 += negativeExponent ? -exponent : exponent;
+  addDouble(numberValue, negative, startPos);
 }
 
 void Parser::parseString() {
@@ -458,10 +1029,18 @@ void Parser::parseArray() {
     return;
   }
 
+  // member objects will likely have the same attribute names
+  KeyShape& shape = keyShape();
+
   while (true) {
     // parse array element itself
     _builderPtr->reportAdd();
-    parseJson();
+    if (i == '{') {
+      ++_pos;
+      parseObject(&shape);
+    } else {
+      parseJson();
+    }
     i = skipWhiteSpace("Expecting ',' or ']'");
     if (i == ']') {
       // end of array
@@ -475,13 +1054,22 @@ void Parser::parseArray() {
       throw Exception(Exception::ParseError, "Expecting ',' or ']'");
     }
     ++_pos;  // the ','
+    i = skipWhiteSpace("Expecting item");
   }
 
   // should never get here
   VELOCYPACK_ASSERT(false);
 }
 
-void Parser::parseObject() {
+Parser::KeyShape& Parser::keyShape() {
+  // arrays at the same depth are never open at the same time
+  while (_keyShapes.size() <= _nesting) {
+    _keyShapes.emplace_back(std::make_unique<KeyShape>());
+  }
+  return *_keyShapes[_nesting];
+}
+
+void Parser::parseObject(KeyShape* shape) {
   _builderPtr->addObject();
 
   increaseNesting();
@@ -498,6 +1086,7 @@ void Parser::parseObject() {
     return;
   }
 
+  std::size_t keys = 0;
   while (true) {
     // always expecting a string attribute name here
     if (VELOCYPACK_UNLIKELY(i != '"')) {
@@ -507,26 +1096,49 @@ void Parser::parseObject() {
     ++_pos;
 
     _builderPtr->reportAdd();
-    auto const lastPos = _builderPtr->_pos;
-    parseString();
 
-    if (options->attributeTranslator != nullptr) {
-      // check if a translation for the attribute name exists
-      Slice key(_builderPtr->_start + lastPos);
-
-      if (key.isString()) {
-        uint8_t const* translated =
-            options->attributeTranslator->translate(key.stringView());
-
-        if (translated != nullptr) {
-          // found translation... now reset position to old key position
-          // and simply overwrite the existing key with the numeric translation
-          // id
-          _builderPtr->resetTo(lastPos);
-          _builderPtr->addUInt(Slice(translated).getUInt());
-        }
+    bool predicted = false;
+    if (shape != nullptr && keys < shape->ends.size()) {
+      // if the JSON of the attribute name is the same as in the previous
+      // object, so is its VPack
+      auto const [jsonBegin, vpackBegin] =
+          keys == 0 ? std::pair<std::size_t, std::size_t>(0, 0)
+                    : shape->ends[keys - 1];
+      auto const [jsonEnd, vpackEnd] = shape->ends[keys];
+      std::size_t const jsonLength = jsonEnd - jsonBegin;
+      if (_size - _pos >= jsonLength &&
+          memcmp(_start + _pos, shape->json.data() + jsonBegin, jsonLength) ==
+              0) {
+        std::size_t const vpackLength = vpackEnd - vpackBegin;
+        _builderPtr->reserve(vpackLength);
+        memcpy(_builderPtr->_start + _builderPtr->_pos,
+               shape->vpack.data() + vpackBegin, vpackLength);
+        _builderPtr->advance(vpackLength);
+        _pos += jsonLength;
+        predicted = true;
+      }
+    }
+
+    if (!predicted) {
+      std::size_t const keyPos = _pos;
+      auto const lastPos = _builderPtr->_pos;
+      parseString();
+
+      if (options->attributeTranslator != nullptr) {
+        translateAttributeName(lastPos);
+      }
+
+      if (shape != nullptr) {
+        shape->truncate(keys);
+        shape->json.append(reinterpret_cast<char const*>(_start) + keyPos,
+                           _pos - keyPos);
+        shape->vpack.append(
+            reinterpret_cast<char const*>(_builderPtr->_start) + lastPos,
+            _builderPtr->_pos - lastPos);
+        shape->ends.emplace_back(shape->json.size(), shape->vpack.size());
       }
     }
+    ++keys;
 
     i = skipWhiteSpace("Expecting ':'");
     // always expecting the ':' here
@@ -560,6 +1172,24 @@ void Parser::parseObject() {
   VELOCYPACK_ASSERT(false);
 }
 
+void Parser::translateAttributeName(ValueLength keyPos) {
+  // check if a translation for the attribute name exists
+  Slice key(_builderPtr->_start + keyPos);
+
+  if (key.isString()) {
+    uint8_t const* translated =
+        options->attributeTranslator->translate(key.stringView());
+
+    if (translated != nullptr) {
+      // found translation... now reset position to old key position
+      // and simply overwrite the existing key with the numeric translation
+      // id
+      _builderPtr->resetTo(keyPos);
+      _builderPtr->addUInt(Slice(translated).getUInt());
+    }
+  }
+}
+
 void Parser::parseJson() {
   skipWhiteSpace("Expecting item");  // return value intentionally not checked
 
@@ -596,3 +1226,401 @@ void Parser::parseJson() {
     }
   }
 }
+
+bool Parser::parseJsonProjected(AttributeProjection const& projection) {
+  if (projection.selectsAll()) {
+    parseJson();
+    return true;
+  }
+
+  int i = skipWhiteSpace("Expecting item");
+  if (i == '{') {
+    ++_pos;
+    parseObjectProjected(projection);
+    return true;
+  }
+  if (i == '[') {
+    ++_pos;
+    parseArrayProjected(projection);
+    return true;
+  }
+  if (_nesting == 0) {
+    // top-level scalars are kept
+    parseJson();
+    return true;
+  }
+  skipValue();
+  return false;
+}
+
+void Parser::parseArrayProjected(AttributeProjection const& projection) {
+  _builderPtr->addArray();
+
+  increaseNesting();
+
+  int i = skipWhiteSpace("Expecting item or ']'");
+  if (i == ']') {
+    // empty array
+    ++_pos;  // the closing ']'
+    decreaseNesting();
+    _builderPtr->close();
+    return;
+  }
+
+  while (true) {
+    // members from which nothing is selected are dropped
+    _builderPtr->reportAdd();
+    if (!parseJsonProjected(projection)) {
+      _builderPtr->cleanupAdd();
+    }
+    i = skipWhiteSpace("Expecting ',' or ']'");
+    if (i == ']') {
+      // end of array
+      ++_pos;  // the closing ']'
+      _builderPtr->close();
+      decreaseNesting();
+      return;
+    }
+    // skip over ','
+    if (VELOCYPACK_UNLIKELY(i != ',')) {
+      throw Exception(Exception::ParseError, "Expecting ',' or ']'");
+    }
+    ++_pos;  // the ','
+  }
+
+  // should never get here
+  VELOCYPACK_ASSERT(false);
+}
+
+void Parser::parseObjectProjected(AttributeProjection const& projection) {
+  _builderPtr->addObject();
+
+  increaseNesting();
+  int i = skipWhiteSpace("Expecting item or '}'");
+  if (i == '}') {
+    // empty object
+    consume();  // the closing '}'. return value intentionally not checked
+
+    if (_nesting != 0 || !options->keepTopLevelOpen) {
+      // only close if we've not been asked to keep top level open
+      decreaseNesting();
+      _builderPtr->close();
+    }
+    return;
+  }
+
+  while (true) {
+    // always expecting a string attribute name here
+    if (VELOCYPACK_UNLIKELY(i != '"')) {
+      throw Exception(Exception::ParseError, "Expecting '\"' or '}'");
+    }
+    // get past the initial '"'
+    ++_pos;
+
+    auto lastPos = _builderPtr->_pos;
+    AttributeProjection const* child;
+
+    // look up attribute names without escape sequences in the input, so
+    // that attributes which are not selected are never built
+    uint8_t const* keyStart = _start + _pos;
+    auto keyEnd = static_cast<uint8_t const*>(
+        memchr(keyStart, '"', _size - _pos));
+    if (keyEnd != nullptr &&
+        memchr(keyStart, '\\', keyEnd - keyStart) == nullptr) {
+      child = projection.get(
+          std::string_view(reinterpret_cast<char const*>(keyStart),
+                           static_cast<std::size_t>(keyEnd - keyStart)));
+      if (child == nullptr) {
+        _pos = static_cast<std::size_t>(keyEnd - _start) + 1;
+      } else {
+        _builderPtr->reportAdd();
+        lastPos = _builderPtr->_pos;
+        parseString();
+      }
+    } else {
+      _builderPtr->reportAdd();
+      lastPos = _builderPtr->_pos;
+      parseString();
+      child = projection.get(Slice(_builderPtr->_start + lastPos).stringView());
+      if (child == nullptr) {
+        _builderPtr->cleanupAdd();
+        _builderPtr->resetTo(lastPos);
+      }
+    }
+
+    i = skipWhiteSpace("Expecting ':'");
+    // always expecting the ':' here
+    if (VELOCYPACK_UNLIKELY(i != ':')) {
+      throw Exception(Exception::ParseError, "Expecting ':'");
+    }
+    ++_pos;  // skip over the colon
+
+    if (child == nullptr) {
+      skipValue();
+    } else {
+      if (options->attributeTranslator != nullptr) {
+        translateAttributeName(lastPos);
+      }
+      if (!parseJsonProjected(*child)) {
+        // nothing selected from the value, so drop the attribute
+        _builderPtr->cleanupAdd();
+        _builderPtr->resetTo(lastPos);
+      }
+    }
+
+    i = skipWhiteSpace("Expecting ',' or '}'");
+    if (i == '}') {
+      // end of object
+      ++_pos;  // the closing '}'
+      if (_nesting != 1 || !options->keepTopLevelOpen) {
+        // only close if we've not been asked to keep top level open
+        _builderPtr->close();
+      }
+      decreaseNesting();
+      return;
+    }
+    if (VELOCYPACK_UNLIKELY(i != ',')) {
+      throw Exception(Exception::ParseError, "Expecting ',' or '}'");
+    }
+    // skip over ','
+    ++_pos;  // the ','
+    i = skipWhiteSpace("Expecting '\"' or '}'");
+  }
+
+  // should never get here
+  VELOCYPACK_ASSERT(false);
+}
+
+void Parser::skipValue() {
+  int i = skipWhiteSpace("Expecting item");
+  ++_pos;
+  if (i == '"') {
+    skipString();
+    return;
+  }
+  if (i == '{' || i == '[') {
+    _pos = ::findCompoundEnd(_start, _pos, _size);
+    if (VELOCYPACK_UNLIKELY(_pos == _size)) {
+      throw Exception(Exception::ParseError, "Expecting ']' or '}'");
+    }
+    ++_pos;  // the closing ']' or '}'
+    return;
+  }
+
+  // numbers and literals extend up to the next delimiter. they are not
+  // checked any further
+  --_pos;
+  std::size_t const begin = _pos;
+  while (_pos < _size) {
+    uint8_t c = _start[_pos];
+    if (isWhiteSpace(c) || c == ',' || c == ':' || c == ']' || c == '}' ||
+        c == '[' || c == '{' || c == '"') {
+      break;
+    }
+    ++_pos;
+  }
+  if (VELOCYPACK_UNLIKELY(_pos == begin)) {
+    ++_pos;  // to get error reporting right
+    throw Exception(Exception::ParseError, "Expecting item");
+  }
+}
+
+void Parser::skipString() {
+  while (true) {
+    auto quote =
+        static_cast<uint8_t const*>(memchr(_start + _pos, '"', _size - _pos));
+    if (VELOCYPACK_UNLIKELY(quote == nullptr)) {
+      _pos = _size;
+      throw Exception(Exception::ParseError, "Unfinished string");
+    }
+    std::size_t const end = static_cast<std::size_t>(quote - _start);
+    // the quote is escaped if an odd number of backslashes precedes it
+    std::size_t backslashes = 0;
+    while (end - backslashes > _pos && _start[end - backslashes - 1] == '\\') {
+      ++backslashes;
+    }
+    _pos = end + 1;
+    if ((backslashes & 1) == 0) {
+      return;
+    }
+  }
+}
+
+int Parser::nextStructural(char const* err) {
+  if (VELOCYPACK_UNLIKELY(_structuralPos >= _structurals.size())) {
+    _pos = _size;
+    throw Exception(Exception::ParseError, err);
+  }
+  _pos = _structurals[_structuralPos++];
+  return consume();
+}
+
+void Parser::checkEndOfScalar() {
+  // a scalar is indexed by its first byte only, so the index cannot
+  // tell if there is garbage directly behind it
+  if (_pos < _size && !isWhiteSpace(_start[_pos]) &&
+      (_structuralPos >= _structurals.size() ||
+       _structurals[_structuralPos] != _pos)) {
+    consume();  // to get error reporting right
+    throw Exception(Exception::ParseError, "Expecting ',', ']', '}' or EOF");
+  }
+}
+
+void Parser::parseStringIndexed() {
+  // we have seen the opening '"'. if the next indexed position is the
+  // closing '"', the string does not contain any escape sequences or
+  // control characters, and can be copied as is
+  if (_structuralPos < _structurals.size() &&
+      _start[_structurals[_structuralPos]] == '"') {
+    std::size_t const end = _structurals[_structuralPos];
+    std::size_t const len = end - _pos;
+    uint8_t const* src = _start + _pos;
+    if (options->validateUtf8Strings && !ValidateUtf8String(src, len)) {
+      throw Exception(Exception::InvalidUtf8Sequence);
+    }
+    if (len <= 126) {
+      _builderPtr->reserve(1 + len);
+      _builderPtr->appendByteUnchecked(0x40 + static_cast<uint8_t>(len));
+    } else {
+      _builderPtr->reserve(9 + len);
+      _builderPtr->appendByteUnchecked(0xbf);
+      _builderPtr->appendLengthUnchecked<8>(len);
+    }
+    memcpy(_builderPtr->_start + _builderPtr->_pos, src, len);
+    _builderPtr->advance(len);
+    ++_structuralPos;
+    _pos = end + 1;
+    return;
+  }
+
+  parseString();
+  // skip over the indexed escape sequences and the closing quote
+  while (_structuralPos < _structurals.size() &&
+         _structurals[_structuralPos] < _pos) {
+    ++_structuralPos;
+  }
+}
+
+void Parser::parseArrayIndexed() {
+  _builderPtr->addArray();
+
+  increaseNesting();
+
+  if (peekStructural() == ']') {
+    // empty array
+    nextStructural("");
+    decreaseNesting();
+    _builderPtr->close();
+    return;
+  }
+
+  while (true) {
+    // parse array element itself
+    _builderPtr->reportAdd();
+    parseJsonIndexed();
+    int i = nextStructural("Expecting ',' or ']'");
+    if (i == ']') {
+      // end of array
+      _builderPtr->close();
+      decreaseNesting();
+      return;
+    }
+    if (VELOCYPACK_UNLIKELY(i != ',')) {
+      throw Exception(Exception::ParseError, "Expecting ',' or ']'");
+    }
+  }
+
+  // should never get here
+  VELOCYPACK_ASSERT(false);
+}
+
+void Parser::parseObjectIndexed() {
+  _builderPtr->addObject();
+
+  increaseNesting();
+  int i = nextStructural("Expecting item or '}'");
+  if (i == '}') {
+    // empty object
+    if (_nesting != 0 || !options->keepTopLevelOpen) {
+      // only close if we've not been asked to keep top level open
+      decreaseNesting();
+      _builderPtr->close();
+    }
+    return;
+  }
+
+  while (true) {
+    // always expecting a string attribute name here
+    if (VELOCYPACK_UNLIKELY(i != '"')) {
+      throw Exception(Exception::ParseError, "Expecting '\"' or '}'");
+    }
+
+    _builderPtr->reportAdd();
+    auto const lastPos = _builderPtr->_pos;
+    parseStringIndexed();
+
+    if (options->attributeTranslator != nullptr) {
+      translateAttributeName(lastPos);
+    }
+
+    i = nextStructural("Expecting ':'");
+    // always expecting the ':' here
+    if (VELOCYPACK_UNLIKELY(i != ':')) {
+      throw Exception(Exception::ParseError, "Expecting ':'");
+    }
+
+    parseJsonIndexed();
+
+    i = nextStructural("Expecting ',' or '}'");
+    if (i == '}') {
+      // end of object
+      if (_nesting != 1 || !options->keepTopLevelOpen) {
+        // only close if we've not been asked to keep top level open
+        _builderPtr->close();
+      }
+      decreaseNesting();
+      return;
+    }
+    if (VELOCYPACK_UNLIKELY(i != ',')) {
+      throw Exception(Exception::ParseError, "Expecting ',' or '}'");
+    }
+    i = nextStructural("Expecting '\"' or '}'");
+  }
+
+  // should never get here
+  VELOCYPACK_ASSERT(false);
+}
+
+void Parser::parseJsonIndexed() {
+  int i = nextStructural("Expecting item");
+  switch (i) {
+    case '{':
+      parseObjectIndexed();  // this consumes the closing '}' or throws
+      break;
+    case '[':
+      parseArrayIndexed();  // this consumes the closing ']' or throws
+      break;
+    case '"':
+      parseStringIndexed();
+      break;
+    case 't':
+      parseTrue();  // this consumes "rue" or throws
+      checkEndOfScalar();
+      break;
+    case 'f':
+      parseFalse();  // this consumes "alse" or throws
+      checkEndOfScalar();
+      break;
+    case 'n':
+      parseNull();  // this consumes "ull" or throws
+      checkEndOfScalar();
+      break;
+    default: {
+      // everything else must be a number or is invalid...
+      unconsume();
+      parseNumber();  // this consumes the number or throws
+      checkEndOfScalar();
+      break;
+    }
+  }
+}
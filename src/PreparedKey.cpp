@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/PreparedKey.h"
+#include "velocypack/AttributeTranslator.h"
+#include "velocypack/Exception.h"
+
+using namespace arangodb::velocypack;
+
+PreparedKey::PreparedKey(std::string_view name, Options const* options)
+    : _name(name), _hash(0), _translator(nullptr) {
+  if (VELOCYPACK_UNLIKELY(options == nullptr)) {
+    throw Exception(Exception::InternalError, "Options cannot be a nullptr");
+  }
+
+  // encode the name as a String
+  if (name.size() <= 126) {
+    // short string
+    _encoded.push_back(static_cast<char>(0x40 + name.size()));
+  } else {
+    // long string
+    _encoded.push_back(static_cast<char>(0xbf));
+    uint64_t length = name.size();
+    for (std::size_t i = 0; i < 8; ++i) {
+      _encoded.push_back(static_cast<char>(length & 0xff));
+      length >>= 8;
+    }
+  }
+  _encoded.append(name);
+  _hash = slice().hashString();
+
+  _translator = options->attributeTranslator;
+  if (_translator != nullptr) {
+    uint8_t const* translated = _translator->translate(name);
+    if (translated != nullptr) {
+      _encoded.assign(reinterpret_cast<char const*>(translated),
+                      checkOverflow(Slice(translated).byteSize()));
+    }
+  }
+}
@@ -0,0 +1,213 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/SplicedArray.h"
+#include "velocypack/Exception.h"
+
+#include "array-padding.h"
+
+using namespace arangodb::velocypack;
+
+namespace {
+
+void storeFixed(uint8_t* p, ValueLength value, ValueLength size) noexcept {
+  for (ValueLength i = 0; i < size; ++i) {
+    p[i] = static_cast<uint8_t>(value & 0xff);
+    value >>= 8;
+  }
+}
+
+}  // namespace
+
+SplicedArray::SplicedArray(std::span<Slice const> members,
+                           Options const* options)
+    : _head{}, _headSize(1), _byteSize(1) {
+  if (VELOCYPACK_UNLIKELY(options == nullptr)) {
+    throw Exception(Exception::InternalError, "Options cannot be a nullptr");
+  }
+
+  _members.reserve(members.size());
+  ValueLength totalSize = 0;
+  for (Slice member : members) {
+    ValueLength const size = member.byteSize();
+    _members.emplace_back(member.start(), size);
+    totalSize += size;
+  }
+
+  if (_members.empty()) {
+    _head[0] = 0x01;
+    return;
+  }
+
+  bool compact = options->buildUnindexedArrays;
+  if (options->selectCompactFormat) {
+    // same choice as in Builder::selectsCompactFormat()
+    compact = (_members.size() <= options->compactFormatMaxMembers ||
+               totalSize <= options->compactFormatMaxByteSize) &&
+              std::any_of(_members.begin(), _members.end(),
+                          [&](auto const& member) {
+                            return member.second != _members[0].second;
+                          });
+  }
+  if (!compact || !buildCompact(totalSize)) {
+    buildIndexed(totalSize, options);
+  }
+}
+
+bool SplicedArray::buildCompact(ValueLength totalSize) {
+  ValueLength const n = _members.size();
+  ValueLength const nLen = getVariableValueLength(n);
+  ValueLength byteSize = 1 + totalSize + nLen;
+  ValueLength bLen = getVariableValueLength(byteSize);
+  byteSize += bLen;
+  if (getVariableValueLength(byteSize) != bLen) {
+    byteSize += 1;
+    bLen += 1;
+  }
+  if (bLen >= 9) {
+    // the compact format can only store byte lengths of up to 8 bytes
+    return false;
+  }
+
+  _head[0] = 0x13;
+  storeVariableValueLength<false>(_head.data() + 1, byteSize);
+  _headSize = static_cast<uint8_t>(1 + bLen);
+  _tail.resize(nLen);
+  storeVariableValueLength<true>(_tail.data() + nLen - 1, n);
+  _byteSize = byteSize;
+  return true;
+}
+
+void SplicedArray::buildIndexed(ValueLength totalSize, Options const* options) {
+  std::size_t const n = _members.size();
+
+  // an index table is not needed if all members have the same size
+  bool needIndexTable = false;
+  for (std::size_t i = 1; i < n; ++i) {
+    if (_members[i].second != _members[0].second) {
+      needIndexTable = true;
+      break;
+    }
+  }
+  bool const needNrSubs = needIndexTable;
+
+  // the same decisions as in Builder::closeArray(), where the members
+  // start behind 9 bytes for the header
+  ValueLength const size = 9 + totalSize;
+  ValueLength offsetSize;
+  auto memberHead = [this](std::size_t i) { return *_members[i].first; };
+  bool noPadding = allowsNoPadding(options, _members.size(), 1, memberHead);
+  if (size + (needIndexTable ? n : 0) -
+          (noPadding ? (needNrSubs ? 6 : 7) : 0) <=
+      0xff) {
+    offsetSize = 1;
+  } else {
+    noPadding = allowsNoPadding(options, _members.size(), 2, memberHead);
+    if (size + (needIndexTable ? 2 * n : 0) -
+            (noPadding ? (needNrSubs ? 4 : 6) : 0) <=
+        0xffff) {
+      offsetSize = 2;
+    } else {
+      noPadding = false;
+      if (size + (needIndexTable ? 4 * n : 0) <= 0xffffffffu) {
+        offsetSize = 4;
+      } else {
+        offsetSize = 8;
+      }
+    }
+  }
+
+  if (offsetSize < 8 && !needIndexTable &&
+      options->paddingBehavior == Options::PaddingBehavior::UsePadding) {
+    offsetSize = 8;
+    noPadding = false;
+  }
+
+  uint8_t head = needIndexTable ? 0x06 : 0x02;
+  if (offsetSize == 2) {
+    head += 1;
+  } else if (offsetSize == 4) {
+    head += 2;
+  } else if (offsetSize == 8) {
+    head += 3;
+  }
+
+  ValueLength headSize = 9;
+  if (noPadding) {
+    headSize = 1 + (needIndexTable ? 2 : 1) * offsetSize;
+  }
+
+  if (needIndexTable) {
+    _tail.resize(offsetSize * n + (offsetSize == 8 ? 8 : 0));
+    uint8_t* p = _tail.data();
+    ValueLength offset = headSize;
+    for (auto const& member : _members) {
+      storeFixed(p, offset, offsetSize);
+      p += offsetSize;
+      offset += member.second;
+    }
+    if (offsetSize == 8) {
+      storeFixed(p, n, 8);
+    }
+  }
+
+  _byteSize = headSize + totalSize + _tail.size();
+  _headSize = static_cast<uint8_t>(headSize);
+  _head[0] = head;
+  // byte length and number of members take at most 8 bytes together.
+  // going through a buffer that fits any offset size keeps the writes
+  // provably inside _head
+  std::array<uint8_t, 16> fields{};
+  storeFixed(fields.data(), _byteSize, offsetSize);
+  if (offsetSize < 8 && needNrSubs) {
+    storeFixed(fields.data() + offsetSize, n, offsetSize);
+  }
+  std::memcpy(_head.data() + 1, fields.data(), _head.size() - 1);
+}
+
+void SplicedArray::writeTo(uint8_t* out) const {
+  forEachPiece([&out](uint8_t const* data, ValueLength size) {
+    std::memcpy(out, data, checkOverflow(size));
+    out += size;
+  });
+}
+
+void SplicedArray::writeTo(Sink& sink) const {
+  sink.reserve(_byteSize);
+  forEachPiece([&sink](uint8_t const* data, ValueLength size) {
+    sink.append(reinterpret_cast<char const*>(data), size);
+  });
+}
+
+bool SplicedArray::hasCustomMember() const noexcept {
+  return std::any_of(_members.begin(), _members.end(), [](auto const& member) {
+    return Slice(member.first).isCustom();
+  });
+}
@@ -0,0 +1,429 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/TapeBuilder.h"
+#include "velocypack/AttributeTranslator.h"
+#include "velocypack/Exception.h"
+
+#include "attribute-name-set.h"
+
+using namespace arangodb::velocypack;
+
+namespace {
+
+#ifndef VELOCYPACK_NO_THREADLOCALS
+// thread-local, reusable set to detect duplicate attribute names
+thread_local std::unique_ptr<AttributeNameSet> attributeNames;
+#endif
+
+// maximum byte sizes for the offset sizes 1, 2 and 4
+constexpr ValueLength maxSizes[] = {0xff, 0xffff, 0xffffffffULL};
+
+// returns the attribute name at p, translating it if necessary
+std::string_view attributeName(uint8_t const* p) {
+  if (*p >= 0x40 && *p <= 0xbe) {
+    // short string
+    return {reinterpret_cast<char const*>(p + 1),
+            static_cast<std::size_t>(*p - 0x40)};
+  }
+  return Slice(p).makeKey().stringView();
+}
+
+// returns the byte width of the offsets of an Array or Object with an
+// index table or of an Array without one
+ValueLength offsetSizeOf(uint8_t head) noexcept {
+  uint8_t const base = head >= 0x0b ? 0x0b : (head >= 0x06 ? 0x06 : 0x02);
+  return ValueLength(1) << (head - base);
+}
+
+void storeFixed(uint8_t* p, ValueLength value, ValueLength size) noexcept {
+  for (ValueLength i = 0; i < size; ++i) {
+    p[i] = static_cast<uint8_t>(value & 0xff);
+    value >>= 8;
+  }
+}
+
+}  // namespace
+
+TapeBuilder::TapeBuilder(Options const* options)
+    : _values(options), _keyWritten(false), options(options) {
+  if (VELOCYPACK_UNLIKELY(options == nullptr)) {
+    throw Exception(Exception::InternalError, "Options cannot be a nullptr");
+  }
+}
+
+void TapeBuilder::clear() noexcept {
+  _values.clear();
+  _nodes.clear();
+  _stack.clear();
+  _keyWritten = false;
+}
+
+void TapeBuilder::add(Value const& sub) {
+  ValueType const type = sub.valueType();
+  if (type == ValueType::Array || type == ValueType::Object) {
+    bool const unindexed = sub.unindexed();
+    if (VELOCYPACK_UNLIKELY(reportAdd(false))) {
+      throw Exception(Exception::BuilderKeyMustBeString);
+    }
+    openCompound(type == ValueType::Array, unindexed);
+    return;
+  }
+
+  reportAdd(type == ValueType::String || type == ValueType::UInt);
+  ValueLength const start = _values.size();
+  _values.add(sub);
+  addScalar(start);
+}
+
+void TapeBuilder::add(Slice sub) {
+  reportAdd(sub.isString() || sub.isUInt() || sub.isSmallInt());
+  ValueLength const start = _values.size();
+  _values.add(sub);
+  addScalar(start);
+}
+
+void TapeBuilder::addKey(std::string_view attrName) {
+  if (VELOCYPACK_UNLIKELY(_stack.empty() ||
+                          _nodes[_stack.back().node].head != 0x0b)) {
+    throw Exception(Exception::BuilderNeedOpenObject);
+  }
+  if (VELOCYPACK_UNLIKELY(_keyWritten)) {
+    throw Exception(Exception::BuilderKeyAlreadyWritten);
+  }
+
+  ValueLength const start = _values.size();
+  uint8_t const* translated = nullptr;
+  if (options->attributeTranslator != nullptr) {
+    translated = options->attributeTranslator->translate(attrName);
+  }
+  if (translated != nullptr) {
+    _values.add(Slice(translated));
+  } else {
+    _values.add(Value(attrName));
+  }
+  _keyWritten = true;
+  addScalar(start);
+}
+
+bool TapeBuilder::reportAdd(bool isValidKey) {
+  if (_stack.empty()) {
+    return false;
+  }
+  Node& compound = _nodes[_stack.back().node];
+  if (compound.head == 0x0b && !_keyWritten) {
+    if (VELOCYPACK_UNLIKELY(!isValidKey)) {
+      throw Exception(Exception::BuilderKeyMustBeString);
+    }
+    _keyWritten = true;
+    return true;
+  }
+  _keyWritten = false;
+  ++compound.items;
+  return false;
+}
+
+void TapeBuilder::addScalar(ValueLength start) {
+  _nodes.push_back(Node{_values.size() - start, start, 0, 0, false});
+}
+
+void TapeBuilder::openCompound(bool isArray, bool unindexed) {
+  _stack.push_back(OpenCompound{_nodes.size(), unindexed});
+  _nodes.push_back(Node{0, 0, 0, static_cast<uint8_t>(isArray ? 0x06 : 0x0b),
+                        false});
+}
+
+void TapeBuilder::close() {
+  if (VELOCYPACK_UNLIKELY(_stack.empty())) {
+    throw Exception(Exception::BuilderNeedOpenCompound);
+  }
+  if (VELOCYPACK_UNLIKELY(_keyWritten)) {
+    throw Exception(Exception::BuilderKeyAlreadyWritten);
+  }
+  OpenCompound const open = _stack.back();
+  Node& node = _nodes[open.node];
+  node.offset = _nodes.size();
+  closeCompound(node, open.unindexed);
+  _stack.pop_back();
+}
+
+void TapeBuilder::closeCompound(Node& node, bool unindexed) {
+  bool const isArray = node.head == 0x06;
+  ValueLength const n = node.items;
+
+  if (n == 0) {
+    node.head = isArray ? 0x01 : 0x0a;
+    node.size = 1;
+    return;
+  }
+
+  // sum up the sizes of all members. the members of an Object are
+  // pairs of attribute name and value
+  std::size_t const index = static_cast<std::size_t>(&node - _nodes.data());
+  ValueLength payload = 0;
+  ValueLength firstSize = 0;
+  bool sameSize = true;
+  uint8_t firstByte = 0;
+  std::size_t i = index + 1;
+  for (ValueLength m = 0; m < n; ++m) {
+    ValueLength size = 0;
+    for (int part = isArray ? 1 : 2; part > 0; --part) {
+      Node const& member = _nodes[i];
+      if (m == 0 && size == 0) {
+        firstByte = member.head != 0 ? member.head
+                                     : _values.start()[member.offset];
+      }
+      size += member.size;
+      i = member.head != 0 ? static_cast<std::size_t>(member.offset) : i + 1;
+    }
+    if (m == 0) {
+      firstSize = size;
+    } else if (size != firstSize) {
+      sameSize = false;
+    }
+    payload += size;
+  }
+
+  bool compact;
+  if (unindexed || (!isArray && n == 1)) {
+    compact = true;
+  } else if (options->selectCompactFormat) {
+    // same choice as in Builder::selectsCompactFormat()
+    compact = (n <= options->compactFormatMaxMembers ||
+               payload <= options->compactFormatMaxByteSize) &&
+              !(isArray && sameSize);
+  } else {
+    compact = isArray ? options->buildUnindexedArrays
+                      : options->buildUnindexedObjects;
+  }
+  if (compact) {
+    // compact format, if the byte length fits into 8 bytes
+    ValueLength byteSize = 1 + payload + getVariableValueLength(n);
+    ValueLength bLen = getVariableValueLength(byteSize);
+    byteSize += bLen;
+    if (getVariableValueLength(byteSize) != bLen) {
+      byteSize += 1;
+      bLen += 1;
+    }
+    if (bLen < 9) {
+      node.head = isArray ? 0x13 : 0x14;
+      node.size = byteSize;
+      if (!isArray) {
+        checkAttributeUniqueness(node);
+      }
+      return;
+    }
+  }
+
+  // Arrays whose members all have the same size need no index table.
+  // a first member starting with a zero byte could not be told apart
+  // from padding, so the members must then start behind the padding
+  bool const needIndexTable = !isArray || (n > 1 && !sameSize);
+  node.padded = isArray && firstByte == 0x00;
+
+  ValueLength offsetSize = 1;
+  ValueLength size = 0;
+  for (std::size_t k = 0; k < 4; ++k, offsetSize *= 2) {
+    ValueLength header = 1 + offsetSize;
+    if (needIndexTable && offsetSize < 8) {
+      // number of members
+      header += offsetSize;
+    }
+    if (node.padded) {
+      header = 9;
+    }
+    size = header + payload;
+    if (needIndexTable) {
+      size += n * offsetSize + (offsetSize == 8 ? 8 : 0);
+    }
+    if (offsetSize == 8 || size <= ::maxSizes[k]) {
+      break;
+    }
+  }
+
+  uint8_t const base = isArray ? (needIndexTable ? 0x06 : 0x02) : 0x0b;
+  node.head = static_cast<uint8_t>(
+      base + (offsetSize == 1 ? 0 : offsetSize == 2 ? 1 : offsetSize == 4 ? 2 : 3));
+  node.size = size;
+  if (!isArray) {
+    checkAttributeUniqueness(node);
+  }
+}
+
+void TapeBuilder::checkAttributeUniqueness(Node const& node) const {
+  if (!options->checkAttributeUniqueness || node.items < 2) {
+    return;
+  }
+#ifndef VELOCYPACK_NO_THREADLOCALS
+  std::unique_ptr<AttributeNameSet>& names = ::attributeNames;
+  if (names == nullptr) {
+    names = std::make_unique<AttributeNameSet>();
+  }
+#else
+  auto names = std::make_unique<AttributeNameSet>();
+#endif
+  names->reset(checkOverflow(node.items));
+
+  std::size_t i = static_cast<std::size_t>(&node - _nodes.data()) + 1;
+  for (ValueLength m = 0; m < node.items; ++m) {
+    if (!names->insert(::attributeName(_values.start() + _nodes[i].offset))) {
+      throw Exception(Exception::DuplicateAttributeName);
+    }
+    ++i;
+    i = _nodes[i].head != 0 ? static_cast<std::size_t>(_nodes[i].offset) : i + 1;
+  }
+}
+
+ValueLength TapeBuilder::size() const {
+  if (VELOCYPACK_UNLIKELY(!isClosed())) {
+    throw Exception(Exception::BuilderNotSealed);
+  }
+  ValueLength size = 0;
+  for (std::size_t i = 0; i < _nodes.size();) {
+    Node const& node = _nodes[i];
+    size += node.size;
+    i = node.head != 0 ? static_cast<std::size_t>(node.offset) : i + 1;
+  }
+  return size;
+}
+
+void TapeBuilder::writeTo(Builder& builder) const {
+  if (VELOCYPACK_UNLIKELY(!builder.isClosed())) {
+    throw Exception(Exception::BuilderNotSealed);
+  }
+  ValueLength const total = size();
+  builder.reserve(total);
+  uint8_t* out = builder._start + builder._pos;
+  for (std::size_t i = 0; i < _nodes.size();) {
+    i = write(i, out);
+  }
+  VELOCYPACK_ASSERT(out == builder._start + builder._pos + total);
+  builder.advance(total);
+}
+
+std::size_t TapeBuilder::write(std::size_t index, uint8_t*& out) const {
+  Node const& node = _nodes[index];
+  uint8_t const head = node.head;
+  if (head == 0) {
+    memcpy(out, _values.start() + node.offset, checkOverflow(node.size));
+    out += node.size;
+    return index + 1;
+  }
+
+  uint8_t* const start = out;
+  *out = head;
+  if (head == 0x01 || head == 0x0a) {
+    ++out;
+    return index + 1;
+  }
+
+  bool const isArray = head < 0x0a || head == 0x13;
+  ValueLength const n = node.items;
+  std::size_t i = index + 1;
+
+  if (head == 0x13 || head == 0x14) {
+    storeVariableValueLength<false>(start + 1, node.size);
+    out = start + 1 + getVariableValueLength(node.size);
+    for (ValueLength m = 0; m < n; ++m) {
+      i = writeMember(i, out, isArray);
+    }
+    storeVariableValueLength<true>(start + node.size - 1, n);
+    out = start + node.size;
+    return i;
+  }
+
+  ValueLength const offsetSize = offsetSizeOf(head);
+  bool const needIndexTable = head >= 0x06;
+  storeFixed(start + 1, node.size, offsetSize);
+  out = start + 1 + offsetSize;
+  if (needIndexTable && offsetSize < 8) {
+    storeFixed(out, n, offsetSize);
+    out += offsetSize;
+  }
+  if (node.padded) {
+    memset(out, 0, start + 9 - out);
+    out = start + 9;
+  }
+
+  std::size_t const base = _offsets.size();
+  for (ValueLength m = 0; m < n; ++m) {
+    if (needIndexTable) {
+      _offsets.push_back(static_cast<ValueLength>(out - start));
+    }
+    i = writeMember(i, out, isArray);
+  }
+
+  if (needIndexTable) {
+    if (isArray) {
+      for (auto it = _offsets.begin() + base; it != _offsets.end(); ++it) {
+        storeFixed(out, *it, offsetSize);
+        out += offsetSize;
+      }
+    } else {
+      // the index table of an Object is sorted by attribute name. all
+      // members are written by now, so _sortEntries is free for use
+      _sortEntries.clear();
+      for (auto it = _offsets.begin() + base; it != _offsets.end(); ++it) {
+        _sortEntries.emplace_back(::attributeName(start + *it), *it);
+      }
+      std::sort(_sortEntries.begin(), _sortEntries.end(),
+                [](auto const& a, auto const& b) { return a.first < b.first; });
+      for (auto const& entry : _sortEntries) {
+        storeFixed(out, entry.second, offsetSize);
+        out += offsetSize;
+      }
+    }
+    _offsets.resize(base);
+    if (offsetSize == 8) {
+      storeFixed(out, n, 8);
+      out += 8;
+    }
+  }
+  VELOCYPACK_ASSERT(out == start + node.size);
+  return i;
+}
+
+std::size_t TapeBuilder::writeMember(std::size_t index, uint8_t*& out,
+                                     bool isArray) const {
+  if (isArray) {
+    return write(index, out);
+  }
+  Node const& key = _nodes[index];
+  Node const& value = _nodes[index + 1];
+  if (value.head == 0 && value.offset == key.offset + key.size) {
+    // attribute name and scalar value were recorded back to back, so
+    // they can be copied in one go
+    memcpy(out, _values.start() + key.offset,
+           checkOverflow(key.size + value.size));
+    out += key.size + value.size;
+    return index + 2;
+  }
+  return write(write(index, out), out);
+}
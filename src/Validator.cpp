@@ -22,8 +22,8 @@
 /// @author Jan Steemann
 ////////////////////////////////////////////////////////////////////////////////
 
-#include <unordered_set>
 #include <memory>
+#include <string_view>
 
 #include "velocypack/velocypack-common.h"
 #include "velocypack/Validator.h"
@@ -32,9 +32,49 @@
 #include "velocypack/ValueType.h"
 
 #include "asm-functions.h"
+#include "attribute-name-set.h"
 
 using namespace arangodb::velocypack;
 
+namespace {
+
+#ifndef VELOCYPACK_NO_THREADLOCALS
+// thread-local, reusable set to detect duplicate attribute names
+thread_local std::unique_ptr<AttributeNameSet> duplicateKeys;
+#endif
+
+std::unique_ptr<AttributeNameSet> acquireNameSet() {
+#ifndef VELOCYPACK_NO_THREADLOCALS
+  if (::duplicateKeys != nullptr) {
+    return std::move(::duplicateKeys);
+  }
+#endif
+  return std::make_unique<AttributeNameSet>();
+}
+
+void releaseNameSet(std::unique_ptr<AttributeNameSet> names) noexcept {
+#ifndef VELOCYPACK_NO_THREADLOCALS
+  ::duplicateKeys = std::move(names);
+#endif
+}
+
+// adds the name of the attribute at p to names. integer attribute names
+// are added by value
+void checkUniqueName(AttributeNameSet& names, uint8_t const* p) {
+  Slice key(p);
+  bool inserted;
+  if (key.isString()) {
+    inserted = names.insert(key.stringView());
+  } else {
+    inserted = names.insert(key.getUInt());
+  }
+  if (!inserted) {
+    throw Exception(Exception::DuplicateAttributeName);
+  }
+}
+
+}  // namespace
+
 template<bool reverse>
 static ValueLength ReadVariableLengthValue(uint8_t const*& p,
                                            uint8_t const* end) {
@@ -518,6 +558,7 @@ void Validator::validateCompactObject(uint8_t const* ptr, std::size_t length) {
   // validate the object members
   uint8_t const* e = p;
   p = data;
+  ValueLength const n = nrItems;
   while (nrItems-- > 0) {
     if (p >= e) {
       throw Exception(Exception::ValidatorInvalidLength,
@@ -552,6 +593,18 @@ void Validator::validateCompactObject(uint8_t const* ptr, std::size_t length) {
     throw Exception(Exception::ValidatorInvalidLength,
                     "Object has more members than specified");
   }
+
+  if (options->checkAttributeUniqueness && n > 1) {
+    auto names = ::acquireNameSet();
+    names->reset(checkOverflow(n));
+    p = data;
+    while (p < e) {
+      ::checkUniqueName(*names, p);
+      p += Slice(p).byteSize();
+      p += Slice(p).byteSize();
+    }
+    ::releaseNameSet(std::move(names));
+  }
 }
 
 void Validator::validateIndexedObject(uint8_t const* ptr, std::size_t length) {
@@ -638,15 +691,9 @@ void Validator::validateIndexedObject(uint8_t const* ptr, std::size_t length) {
   ValueLength tableBuf[16];  // Fixed space to save offsets found sequentially
   ValueLength* table = tableBuf;
   std::unique_ptr<ValueLength[]> tableGuard;
-  std::unique_ptr<std::unordered_set<ValueLength>> offsetSet;
   if (nrItems > 16) {
-    if (nrItems <= 128) {
-      table = new ValueLength[nrItems];  // throws if bad_alloc
-      tableGuard.reset(table);           // for automatic deletion
-    } else {
-      // if we have even more items, we directly create an unordered_set
-      offsetSet = std::make_unique<std::unordered_set<ValueLength>>();
-    }
+    table = new ValueLength[nrItems];  // throws if bad_alloc
+    tableGuard.reset(table);           // for automatic deletion
   }
   ValueLength actualNrItems = 0;
   uint8_t const* member = firstMember;
@@ -676,20 +723,14 @@ void Validator::validateIndexedObject(uint8_t const* ptr, std::size_t length) {
     }
     validatePart(value, indexTable - value, true);
 
-    ValueLength offset = static_cast<ValueLength>(member - ptr);
-    if (nrItems <= 128) {
-      table[actualNrItems] = offset;
-    } else {
-      offsetSet->emplace(offset);
-    }
-
-    member += keySize + Slice(value).byteSize();
-    ++actualNrItems;
-
-    if (actualNrItems > nrItems) {
+    if (actualNrItems == nrItems) {
       throw Exception(Exception::ValidatorInvalidLength,
                       "Object value has more key/value pairs than announced");
     }
+    table[actualNrItems] = static_cast<ValueLength>(member - ptr);
+    ++actualNrItems;
+
+    member += keySize + Slice(value).byteSize();
   }
 
   if (actualNrItems < nrItems) {
@@ -697,41 +738,62 @@ void Validator::validateIndexedObject(uint8_t const* ptr, std::size_t length) {
                     "Object has fewer items than in index");
   }
 
-  // Finally verify each offset in the index:
-  if (nrItems <= 128) {
+  // Finally verify each offset in the index. the offsets of the members
+  // in the table are ascending, so each one can be found by binary
+  // search. found offsets are marked so that they cannot be used twice
+  constexpr ValueLength found = ValueLength(1) << 63;
+  for (ValueLength pos = 0; pos < nrItems; ++pos) {
+    ValueLength offset = readIntegerNonEmpty<ValueLength>(
+        indexTable + pos * byteSizeLength, byteSizeLength);
+    ValueLength low = 0;
+    ValueLength high = nrItems;
+    bool valid = false;
+    while (low < high) {
+      ValueLength mid = (low + high) / 2;
+      ValueLength const current = table[mid] & ~found;
+      if (offset == current) {
+        valid = (table[mid] & found) == 0;
+        table[mid] |= found;
+        break;
+      } else if (offset < current) {
+        high = mid;
+      } else {  // offset > current
+        low = mid + 1;
+      }
+    }
+    if (!valid) {
+      throw Exception(Exception::ValidatorInvalidLength,
+                      "Object has invalid index offset");
+    }
+  }
+
+  if (options->checkAttributeUniqueness && nrItems > 1) {
+    // the index table is sorted by attribute name. if the names in it
+    // strictly increase, they are unique. otherwise fall back to a hash
+    // set over all names
+    bool increasing = true;
+    std::string_view previous;
     for (ValueLength pos = 0; pos < nrItems; ++pos) {
-      ValueLength offset = readIntegerNonEmpty<ValueLength>(
-          indexTable + pos * byteSizeLength, byteSizeLength);
-      // Binary search in sorted index list:
-      ValueLength low = 0;
-      ValueLength high = nrItems;
-      bool found = false;
-      while (low < high) {
-        ValueLength mid = (low + high) / 2;
-        if (offset == table[mid]) {
-          found = true;
-          break;
-        } else if (offset < table[mid]) {
-          high = mid;
-        } else {  // offset > table[mid]
-          low = mid + 1;
-        }
+      Slice key(ptr + readIntegerNonEmpty<ValueLength>(
+                          indexTable + pos * byteSizeLength, byteSizeLength));
+      if (!key.isString()) {
+        increasing = false;
+        break;
       }
-      if (!found) {
-        throw Exception(Exception::ValidatorInvalidLength,
-                        "Object has invalid index offset");
+      std::string_view name = key.stringView();
+      if (pos > 0 && !(previous < name)) {
+        increasing = false;
+        break;
       }
+      previous = name;
     }
-  } else {
-    for (ValueLength pos = 0; pos < nrItems; ++pos) {
-      ValueLength offset = readIntegerNonEmpty<ValueLength>(
-          indexTable + pos * byteSizeLength, byteSizeLength);
-      auto i = offsetSet->find(offset);
-      if (i == offsetSet->end()) {
-        throw Exception(Exception::ValidatorInvalidLength,
-                        "Object has invalid index offset");
+    if (!increasing) {
+      auto names = ::acquireNameSet();
+      names->reset(checkOverflow(nrItems));
+      for (ValueLength pos = 0; pos < nrItems; ++pos) {
+        ::checkUniqueName(*names, ptr + (table[pos] & ~found));
       }
-      offsetSet->erase(i);
+      ::releaseNameSet(std::move(names));
     }
   }
 }
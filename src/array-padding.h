@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "velocypack/velocypack-common.h"
+#include "velocypack/Options.h"
+
+namespace arangodb::velocypack {
+
+// checks whether the padding behind the header of an indexed Array with n
+// members and the given offset size may be left out. headByte(i) returns
+// the first byte of member i. a None (0x00) as one of the first members
+// could not be told apart from padding, so it forces padding. used by both
+// Builder::closeArray() and SplicedArray, which must produce the same layout
+template<typename F>
+bool allowsNoPadding(Options const* options, std::size_t n,
+                     ValueLength offsetSize, F&& headByte) {
+  VELOCYPACK_ASSERT(offsetSize == 1 || offsetSize == 2);
+
+  if (options->paddingBehavior == Options::PaddingBehavior::NoPadding ||
+      (offsetSize == 1 &&
+       options->paddingBehavior == Options::PaddingBehavior::Flexible)) {
+    n = (std::min)(std::size_t(8 - 2 * offsetSize), n);
+    for (std::size_t i = 0; i < n; i++) {
+      if (headByte(i) == 0x00) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace arangodb::velocypack
@@ -86,6 +86,49 @@ inline bool ValidateUtf8StringC(uint8_t const* src, std::size_t limit) {
   return Utf8Helper::isValidUtf8(src, static_cast<ValueLength>(limit));
 }
 
+void JSONClassifyBlockC(uint8_t const* src, JSONBlockMasks& masks) {
+  masks = JSONBlockMasks{0, 0, 0, 0, 0};
+  for (std::size_t i = 0; i < 64; ++i) {
+    uint64_t const bit = uint64_t(1) << i;
+    switch (src[i]) {
+      case '"':
+        masks.quote |= bit;
+        break;
+      case '\\':
+        masks.backslash |= bit;
+        break;
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+      case ':':
+      case ',':
+        masks.structural |= bit;
+        break;
+      case 0x0c:
+      case 0x1a:
+        // same classification as in the vectorized variant
+        masks.structural |= bit;
+        masks.control |= bit;
+        break;
+      case ' ':
+        masks.whitespace |= bit;
+        break;
+      case '\t':
+      case '\n':
+      case '\r':
+        masks.whitespace |= bit;
+        masks.control |= bit;
+        break;
+      default:
+        if (src[i] < 0x20) {
+          masks.control |= bit;
+        }
+        break;
+    }
+  }
+}
+
 #if defined(__SSE4_2__) && VELOCYPACK_ASM_OPTIMIZATIONS == 1
 bool hasSSE42() noexcept {
   unsigned int eax, ebx, ecx, edx;
@@ -208,6 +251,54 @@ std::size_t JSONSkipWhiteSpaceSSE42(uint8_t const* ptr, std::size_t limit) {
   return count;
 }
 
+#endif
+#if VELOCYPACK_ASM_OPTIMIZATIONS == 1 && \
+    (defined(__SSE4_2__) || defined(__aarch64__))
+
+void JSONClassifyBlockSSE42(uint8_t const* src, JSONBlockMasks& masks) {
+  // whitespace and structural characters are found via table lookups
+  // indexed by the low nibble of each byte. bytes with the high bit set
+  // look up 0 and thus never match.
+  __m128i const whitespaceTable =
+      _mm_setr_epi8(' ', 100, 100, 100, 17, 100, 113, 2, 100, '\t', '\n', 112,
+                    100, '\r', 100, 100);
+  // setting bit 0x20 turns '[' into '{' and ']' into '}'. this also
+  // classifies the control characters 0x0c and 0x1a as structural, but
+  // these are invalid outside of strings anyway
+  __m128i const structuralTable =
+      _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ':', '{', ',', '}', 0, 0);
+  __m128i const quote = _mm_set1_epi8('"');
+  __m128i const backslash = _mm_set1_epi8('\\');
+  __m128i const bit5 = _mm_set1_epi8(0x20);
+  __m128i const controlMax = _mm_set1_epi8(0x1f);
+
+  auto bits = [](__m128i v) -> uint64_t {
+    return static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(v)));
+  };
+
+  uint64_t q = 0, b = 0, st = 0, ws = 0, c = 0;
+  for (std::size_t i = 0; i < 4; ++i) {
+    __m128i const s =
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + 16 * i));
+    std::size_t const shift = 16 * i;
+    q |= bits(_mm_cmpeq_epi8(s, quote)) << shift;
+    b |= bits(_mm_cmpeq_epi8(s, backslash)) << shift;
+    st |= bits(_mm_cmpeq_epi8(_mm_or_si128(s, bit5),
+                              _mm_shuffle_epi8(structuralTable, s)))
+          << shift;
+    ws |= bits(_mm_cmpeq_epi8(s, _mm_shuffle_epi8(whitespaceTable, s)))
+          << shift;
+    // unsigned s <= 0x1f
+    c |= bits(_mm_cmpeq_epi8(_mm_max_epu8(s, controlMax), controlMax))
+         << shift;
+  }
+  masks.quote = q;
+  masks.backslash = b;
+  masks.structural = st;
+  masks.whitespace = ws;
+  masks.control = c;
+}
+
 #endif
 #if VELOCYPACK_ASM_OPTIMIZATIONS == 1
 
@@ -219,11 +310,21 @@ bool ValidateUtf8StringSSE42(uint8_t const* src, std::size_t len) {
 }
 
 #endif
-#if defined(__AVX2__) && VELOCYPACK_ASM_OPTIMIZATIONS == 1
+#ifdef VELOCYPACK_AVX2_KERNELS
 
 bool hasAVX2() noexcept {
   unsigned int eax, ebx, ecx, edx;
-  if (__get_cpuid(7, &eax, &ebx, &ecx, &edx)) {
+  // the OS must also save the upper halves of the YMM registers
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & bit_OSXSAVE) == 0 ||
+      (ecx & bit_AVX) == 0) {
+    return false;
+  }
+  unsigned int xcr0Low, xcr0High;
+  __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+  if ((xcr0Low & 0x6) != 0x6) {
+    return false;
+  }
+  if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
     if ((ebx & bit_AVX2) != 0) {
       return true;
     }
@@ -231,13 +332,140 @@ bool hasAVX2() noexcept {
   return false;
 }
 
-bool ValidateUtf8StringAVX(uint8_t const* src, std::size_t len) {
+VELOCYPACK_AVX2_BEGIN
+
+// returns the bits of all bytes in s that end a string copy, i.e. control
+// characters, '"' and '\\'
+inline uint32_t stringCopyStops(__m256i s) noexcept {
+  __m256i const quote = _mm256_set1_epi8('"');
+  __m256i const backslash = _mm256_set1_epi8('\\');
+  __m256i const controlMax = _mm256_set1_epi8(0x1f);
+  __m256i const stops = _mm256_or_si256(
+      _mm256_or_si256(_mm256_cmpeq_epi8(s, quote),
+                      _mm256_cmpeq_epi8(s, backslash)),
+      _mm256_cmpeq_epi8(_mm256_max_epu8(s, controlMax), controlMax));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(stops));
+}
+
+std::size_t JSONStringCopyAVX2(uint8_t* dst, uint8_t const* src,
+                               std::size_t limit) {
+  std::size_t count = 0;
+  while (limit >= 32) {
+    __m256i const s =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src));
+    uint32_t const stops = stringCopyStops(s);
+    if (stops != 0) {
+      std::size_t const x = static_cast<std::size_t>(__builtin_ctz(stops));
+      memcpy(dst, src, x);
+      return count + x;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), s);
+    src += 32;
+    dst += 32;
+    limit -= 32;
+    count += 32;
+  }
+  return count + JSONStringCopySSE42(dst, src, limit);
+}
+
+std::size_t JSONStringCopyCheckUtf8AVX2(uint8_t* dst, uint8_t const* src,
+                                        std::size_t limit) {
+  std::size_t count = 0;
+  while (limit >= 32) {
+    __m256i const s =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src));
+    // also stop at bytes with the high bit set
+    uint32_t const stops =
+        stringCopyStops(s) | static_cast<uint32_t>(_mm256_movemask_epi8(s));
+    if (stops != 0) {
+      std::size_t const x = static_cast<std::size_t>(__builtin_ctz(stops));
+      memcpy(dst, src, x);
+      return count + x;
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), s);
+    src += 32;
+    dst += 32;
+    limit -= 32;
+    count += 32;
+  }
+  return count + JSONStringCopyCheckUtf8SSE42(dst, src, limit);
+}
+
+std::size_t JSONSkipWhiteSpaceAVX2(uint8_t const* ptr, std::size_t limit) {
+  __m256i const space = _mm256_set1_epi8(' ');
+  __m256i const tab = _mm256_set1_epi8('\t');
+  __m256i const newline = _mm256_set1_epi8('\n');
+  __m256i const carriageReturn = _mm256_set1_epi8('\r');
+  std::size_t count = 0;
+  while (limit >= 32) {
+    __m256i const s =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const*>(ptr));
+    __m256i const white = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(s, space), _mm256_cmpeq_epi8(s, tab)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(s, newline),
+                        _mm256_cmpeq_epi8(s, carriageReturn)));
+    uint32_t const other = ~static_cast<uint32_t>(_mm256_movemask_epi8(white));
+    if (other != 0) {
+      return count + static_cast<std::size_t>(__builtin_ctz(other));
+    }
+    ptr += 32;
+    limit -= 32;
+    count += 32;
+  }
+  return count + JSONSkipWhiteSpaceSSE42(ptr, limit);
+}
+
+void JSONClassifyBlockAVX2(uint8_t const* src, JSONBlockMasks& masks) {
+  // same approach as JSONClassifyBlockSSE42. the shuffles work on each
+  // 128 bit lane separately, so the tables are repeated for both lanes
+  __m256i const whitespaceTable = _mm256_setr_epi8(
+      ' ', 100, 100, 100, 17, 100, 113, 2, 100, '\t', '\n', 112, 100, '\r', 100,
+      100, ' ', 100, 100, 100, 17, 100, 113, 2, 100, '\t', '\n', 112, 100, '\r',
+      100, 100);
+  __m256i const structuralTable = _mm256_setr_epi8(
+      0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ':', '{', ',', '}', 0, 0, 0, 0, 0, 0, 0, 0,
+      0, 0, 0, 0, ':', '{', ',', '}', 0, 0);
+  __m256i const quote = _mm256_set1_epi8('"');
+  __m256i const backslash = _mm256_set1_epi8('\\');
+  __m256i const bit5 = _mm256_set1_epi8(0x20);
+  __m256i const controlMax = _mm256_set1_epi8(0x1f);
+
+  auto bits = [](__m256i v) -> uint64_t {
+    return static_cast<uint64_t>(
+        static_cast<uint32_t>(_mm256_movemask_epi8(v)));
+  };
+
+  uint64_t q = 0, b = 0, st = 0, ws = 0, c = 0;
+  for (std::size_t i = 0; i < 2; ++i) {
+    __m256i const s =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + 32 * i));
+    std::size_t const shift = 32 * i;
+    q |= bits(_mm256_cmpeq_epi8(s, quote)) << shift;
+    b |= bits(_mm256_cmpeq_epi8(s, backslash)) << shift;
+    st |= bits(_mm256_cmpeq_epi8(_mm256_or_si256(s, bit5),
+                                 _mm256_shuffle_epi8(structuralTable, s)))
+          << shift;
+    ws |= bits(_mm256_cmpeq_epi8(s, _mm256_shuffle_epi8(whitespaceTable, s)))
+          << shift;
+    c |= bits(_mm256_cmpeq_epi8(_mm256_max_epu8(s, controlMax), controlMax))
+         << shift;
+  }
+  masks.quote = q;
+  masks.backslash = b;
+  masks.structural = st;
+  masks.whitespace = ws;
+  masks.control = c;
+}
+
+bool ValidateUtf8StringAVX2(uint8_t const* src, std::size_t len) {
   if (len >= 32) {
     return validate_utf8_fast_avx(src, len);
   }
   return Utf8Helper::isValidUtf8(src, len);
 }
 
+VELOCYPACK_AVX2_END
+
 #endif
 
 struct EnableNative {
@@ -259,30 +487,54 @@ std::size_t (*JSONSkipWhiteSpace)(uint8_t const*,
 
 bool (*ValidateUtf8String)(uint8_t const*, std::size_t) = ValidateUtf8StringC;
 
+void (*JSONClassifyBlock)(uint8_t const*,
+                          JSONBlockMasks&) = JSONClassifyBlockC;
+
 void enableNativeStringFunctions() noexcept {
   enableBuiltinStringFunctions();
+  if (!enableAVX2StringFunctions()) {
+    enableSSE42StringFunctions();
+  }
+}
+
+void enableBuiltinStringFunctions() noexcept {
+  JSONStringCopy = JSONStringCopyC;
+  JSONStringCopyCheckUtf8 = JSONStringCopyCheckUtf8C;
+  JSONSkipWhiteSpace = JSONSkipWhiteSpaceC;
+  ValidateUtf8String = ValidateUtf8StringC;
+  JSONClassifyBlock = JSONClassifyBlockC;
+}
+
+bool enableSSE42StringFunctions() noexcept {
 #if defined(__SSE4_2__) && VELOCYPACK_ASM_OPTIMIZATIONS == 1
   if (hasSSE42()) {
     JSONStringCopy = JSONStringCopySSE42;
     JSONStringCopyCheckUtf8 = JSONStringCopyCheckUtf8SSE42;
     JSONSkipWhiteSpace = JSONSkipWhiteSpaceSSE42;
     ValidateUtf8String = ValidateUtf8StringSSE42;
+    JSONClassifyBlock = JSONClassifyBlockSSE42;
+    return true;
   }
 #elif defined(__aarch64__) && VELOCYPACK_ASM_OPTIMIZATIONS == 1
   ValidateUtf8String = ValidateUtf8StringSSE42;
+  JSONClassifyBlock = JSONClassifyBlockSSE42;
+  return true;
 #endif
-#if defined(__AVX2__) && VELOCYPACK_ASM_OPTIMIZATIONS == 1
-  if (hasAVX2()) {
-    ValidateUtf8String = ValidateUtf8StringAVX;
-  }
-#endif
+  return false;
 }
 
-void enableBuiltinStringFunctions() noexcept {
-  JSONStringCopy = JSONStringCopyC;
-  JSONStringCopyCheckUtf8 = JSONStringCopyCheckUtf8C;
-  JSONSkipWhiteSpace = JSONSkipWhiteSpaceC;
-  ValidateUtf8String = ValidateUtf8StringC;
+bool enableAVX2StringFunctions() noexcept {
+#ifdef VELOCYPACK_AVX2_KERNELS
+  if (hasSSE42() && hasAVX2()) {
+    JSONStringCopy = JSONStringCopyAVX2;
+    JSONStringCopyCheckUtf8 = JSONStringCopyCheckUtf8AVX2;
+    JSONSkipWhiteSpace = JSONSkipWhiteSpaceAVX2;
+    ValidateUtf8String = ValidateUtf8StringAVX2;
+    JSONClassifyBlock = JSONClassifyBlockAVX2;
+    return true;
+  }
+#endif
+  return false;
 }
 
 }  // namespace arangodb::velocypack
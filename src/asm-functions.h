@@ -40,7 +40,27 @@ extern std::size_t (*JSONSkipWhiteSpace)(uint8_t const*, std::size_t);
 // check string for invalid utf-8 sequences
 extern bool (*ValidateUtf8String)(uint8_t const*, std::size_t);
 
+// character classes of a block of 64 input bytes, one bit per byte
+struct JSONBlockMasks {
+  uint64_t quote;       // '"'
+  uint64_t backslash;   // '\\'
+  uint64_t structural;  // '{', '}', '[', ']', ':' and ','
+  uint64_t whitespace;  // ' ', '\t', '\n' and '\r'
+  uint64_t control;     // bytes < 0x20
+};
+
+// classify 64 bytes of JSON input:
+extern void (*JSONClassifyBlock)(uint8_t const*, JSONBlockMasks&);
+
+// select the fastest implementations the CPU supports. this is done at
+// startup
 void enableNativeStringFunctions() noexcept;
+// select the portable implementations
 void enableBuiltinStringFunctions() noexcept;
+// select the SSE4.2 or AVX2 implementations. these return false and
+// change nothing if the implementations are not available in this build
+// or on this CPU
+bool enableSSE42StringFunctions() noexcept;
+bool enableAVX2StringFunctions() noexcept;
 
 }  // namespace arangodb::velocypack
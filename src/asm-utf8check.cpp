@@ -211,7 +211,8 @@ bool validate_utf8_fast_sse42(uint8_t const* src, std::size_t len) {
   return _mm_testz_si128(has_error, has_error);
 }
 
-#ifdef __AVX2__
+#ifdef VELOCYPACK_AVX2_KERNELS
+VELOCYPACK_AVX2_BEGIN
 
 /*****************************/
 static inline __m256i push_last_byte_of_a_to_b(__m256i a, __m256i b) {
@@ -474,7 +475,8 @@ bool validate_utf8_fast_avx(uint8_t const* src, std::size_t len) {
   return _mm256_testz_si256(has_error, has_error);
 }
 
-#endif  // __AVX2__
+VELOCYPACK_AVX2_END
+#endif  // VELOCYPACK_AVX2_KERNELS
 
 }  // namespace arangodb::velocypack
 
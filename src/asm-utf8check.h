@@ -26,14 +26,32 @@
 #include <cstddef>
 #include <cstdint>
 
+// AVX2 code is compiled even if the compiler does not generally target
+// AVX2, and is selected at runtime if the CPU supports it
+#if VELOCYPACK_ASM_OPTIMIZATIONS == 1 && defined(__SSE4_2__) && \
+    defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define VELOCYPACK_AVX2_KERNELS 1
+#if defined(__clang__)
+#define VELOCYPACK_AVX2_BEGIN \
+  _Pragma(                    \
+      "clang attribute push(__attribute__((target(\"avx2\"))), apply_to = function)")
+#define VELOCYPACK_AVX2_END _Pragma("clang attribute pop")
+#else
+#define VELOCYPACK_AVX2_BEGIN \
+  _Pragma("GCC push_options") _Pragma("GCC target(\"avx2\")")
+#define VELOCYPACK_AVX2_END _Pragma("GCC pop_options")
+#endif
+#endif
+
 namespace arangodb::velocypack {
 
 #if VELOCYPACK_ASM_OPTIMIZATIONS == 1
 bool validate_utf8_fast_sse42(uint8_t const* src, std::size_t len);
-#ifdef __AVX2__
+#ifdef VELOCYPACK_AVX2_KERNELS
+// only call these if the CPU supports AVX2
 bool validate_utf8_fast_avx_asciipath(char const* src, std::size_t len);
 bool validate_utf8_fast_avx(uint8_t const* src, std::size_t len);
-#endif  // __AVX2__
+#endif  // VELOCYPACK_AVX2_KERNELS
 #endif  // VELOCYPACK_ASM_OPTIMIZATIONS
 
 }  // namespace arangodb::velocypack
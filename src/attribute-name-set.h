@@ -0,0 +1,118 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "velocypack/velocypack-common.h"
+
+namespace arangodb::velocypack {
+
+// An open-addressing hash set of attribute names, used to detect
+// duplicate attribute names in Objects. The names are not copied, so
+// they must stay valid until the next reset(). The memory of the set is
+// kept across reset() calls, and resetting does not need to touch the
+// slots, so one set can cheaply be reused for many Objects.
+class AttributeNameSet {
+  struct Slot {
+    // for integer attribute names, this holds the integer itself
+    uint64_t hash;
+    char const* data;
+    std::size_t size;
+    // the slot is used iff this equals _generation
+    uint32_t generation;
+    // attribute names that are integers are kept apart from strings
+    bool isInteger;
+  };
+
+ public:
+  // prepares the set for up to n attribute names
+  void reset(std::size_t n) {
+    std::size_t capacity = 16;
+    while (capacity < 2 * n) {
+      capacity *= 2;
+    }
+    if (capacity > _slots.size()) {
+      _slots.assign(capacity, Slot{0, nullptr, 0, 0, false});
+      _generation = 0;
+    }
+    if (++_generation == 0) {
+      // wrapped around, so old slots could look used
+      for (auto& slot : _slots) {
+        slot.generation = 0;
+      }
+      _generation = 1;
+    }
+    _mask = capacity - 1;
+  }
+
+  // inserts the name, and returns false if it was already contained
+  bool insert(std::string_view name) {
+    uint64_t const hash = VELOCYPACK_HASH(name.data(), name.size(), 0xdeadbeef);
+    std::size_t i = static_cast<std::size_t>(hash) & _mask;
+    while (true) {
+      Slot& slot = _slots[i];
+      if (slot.generation != _generation) {
+        slot = Slot{hash, name.data(), name.size(), _generation, false};
+        return true;
+      }
+      if (slot.hash == hash && slot.size == name.size() && !slot.isInteger &&
+          std::memcmp(slot.data, name.data(), name.size()) == 0) {
+        return false;
+      }
+      i = (i + 1) & _mask;
+    }
+  }
+
+  // inserts the integer attribute name, and returns false if it was
+  // already contained. integers are compared by value, so the same
+  // integer in different VPack encodings counts as a duplicate
+  bool insert(uint64_t value) {
+    uint64_t const hash = VELOCYPACK_HASH(&value, sizeof(value), 0xdeadbeef);
+    std::size_t i = static_cast<std::size_t>(hash) & _mask;
+    while (true) {
+      Slot& slot = _slots[i];
+      if (slot.generation != _generation) {
+        slot = Slot{value, nullptr, 0, _generation, true};
+        return true;
+      }
+      if (slot.isInteger && slot.hash == value) {
+        return false;
+      }
+      i = (i + 1) & _mask;
+    }
+  }
+
+ private:
+  std::vector<Slot> _slots;
+  std::size_t _mask = 0;
+  uint32_t _generation = 0;
+};
+
+}  // namespace arangodb::velocypack
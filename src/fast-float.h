@@ -0,0 +1,47 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace arangodb::velocypack {
+
+// Converts the decimal value mantissa * 10^exponent10 into the nearest
+// double, using Clinger's fast path or the Eisel-Lemire algorithm.
+// If truncated is true, the mantissa only contains the leading digits
+// of the number, and further non-zero digits were dropped.
+// Returns false if the result cannot be determined reliably this way.
+// In this case the caller must use parseDouble() instead.
+// Values too large for a double are returned as infinity, values too
+// small as 0.
+bool decimalToDouble(uint64_t mantissa, int64_t exponent10, bool truncated,
+                     double& result) noexcept;
+
+// Slow, but correctly rounded and locale-independent conversion of the
+// JSON number in [start, end) into a double. Returns false if the value
+// is out of the range of a double.
+bool parseDouble(char const* start, char const* end, double& result) noexcept;
+
+}  // namespace arangodb::velocypack
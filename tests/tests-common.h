@@ -23,23 +23,34 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "velocypack/velocypack-common.h"
+#include "velocypack/ArrayStreamer.h"
+#include "velocypack/AttributeProjection.h"
 #include "velocypack/AttributeTranslator.h"
 #include "velocypack/Basics.h"
+#include "velocypack/BatchBuilder.h"
 #include "velocypack/Buffer.h"
 #include "velocypack/Builder.h"
 #include "velocypack/Collection.h"
 #include "velocypack/Compare.h"
+#include "velocypack/CompiledPath.h"
 #include "velocypack/Dumper.h"
 #include "velocypack/Exception.h"
 #include "velocypack/HashedStringRef.h"
 #include "velocypack/HexDump.h"
+#include "velocypack/IncrementalParser.h"
 #include "velocypack/Iterator.h"
+#include "velocypack/ObjectIndex.h"
+#include "velocypack/OffsetCache.h"
 #include "velocypack/Options.h"
 #include "velocypack/Parser.h"
+#include "velocypack/PreparedKey.h"
+#include "velocypack/SaxParser.h"
 #include "velocypack/Sink.h"
 #include "velocypack/Slice.h"
 #include "velocypack/SliceContainer.h"
+#include "velocypack/SplicedArray.h"
 #include "velocypack/StringRef.h"
+#include "velocypack/TapeBuilder.h"
 #include "velocypack/Validator.h"
 #include "velocypack/Value.h"
 #include "velocypack/ValueType.h"
@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <sstream>
+#include <string>
+
+#include "tests-common.h"
+
+namespace {
+
+// checks that data holds a sequence of valid Arrays and returns their
+// members in order
+std::vector<std::string> membersOf(std::string const& data,
+                                   std::size_t& numArrays) {
+  std::vector<std::string> result;
+  numArrays = 0;
+  Validator validator;
+  std::size_t pos = 0;
+  while (pos < data.size()) {
+    Slice s(reinterpret_cast<uint8_t const*>(data.data() + pos));
+    EXPECT_TRUE(s.isArray());
+    EXPECT_TRUE(validator.validate(data.data() + pos, s.byteSize()));
+    for (Slice member : ArrayIterator(s)) {
+      result.push_back(member.copyString());
+    }
+    pos += s.byteSize();
+    ++numArrays;
+  }
+  EXPECT_EQ(data.size(), pos);
+  return result;
+}
+
+}  // namespace
+
+TEST(ArrayStreamerTest, SeekableEmpty) {
+  std::string out;
+  StringSink sink(&out);
+  ArrayStreamer streamer(sink);
+  ValueLength offset = streamer.finish();
+  ASSERT_EQ(8UL, offset);
+  ASSERT_EQ(9UL, out.size());
+  Slice s(reinterpret_cast<uint8_t const*>(out.data() + offset));
+  ASSERT_TRUE(s.isEmptyArray());
+}
+
+TEST(ArrayStreamerTest, Seekable) {
+  for (std::size_t n : {1, 10, 127, 128, 1000, 20000}) {
+    std::string out = "prefix";
+    StringSink sink(&out);
+    ArrayStreamer streamer(sink);
+    for (std::size_t i = 0; i < n; ++i) {
+      if (i % 2 == 0) {
+        streamer.builder().add(Value(std::to_string(i)));
+        streamer.next();
+      } else {
+        Builder b;
+        b.add(Value(std::to_string(i)));
+        streamer.add(b.slice());
+      }
+      ASSERT_TRUE(streamer.builder().isEmpty());
+    }
+    ASSERT_EQ(n, streamer.length());
+    ValueLength offset = streamer.finish();
+
+    ASSERT_EQ("prefix", out.substr(0, 6));
+    std::string data = out.substr(6 + offset);
+    std::size_t numArrays;
+    auto members = membersOf(data, numArrays);
+    ASSERT_EQ(1UL, numArrays);
+    Slice s(reinterpret_cast<uint8_t const*>(data.data()));
+    ASSERT_EQ(0x13, s.head());
+    ASSERT_EQ(n, members.size());
+    for (std::size_t i = 0; i < n; ++i) {
+      ASSERT_EQ(std::to_string(i), members[i]);
+    }
+  }
+}
+
+TEST(ArrayStreamerTest, SeekableStream) {
+  std::ostringstream stream;
+  SeekableStreamSinkImpl<std::ostringstream> sink(&stream);
+  ArrayStreamer streamer(sink);
+  for (int i = 0; i < 100; ++i) {
+    Builder& b = streamer.builder();
+    b.openObject();
+    b.add("value", Value(i));
+    b.close();
+    streamer.next();
+  }
+  ValueLength offset = streamer.finish();
+
+  std::string out = stream.str();
+  Slice s(reinterpret_cast<uint8_t const*>(out.data() + offset));
+  ASSERT_EQ(out.size() - offset, s.byteSize());
+  Validator validator;
+  ASSERT_TRUE(validator.validate(s.start(), s.byteSize()));
+  ASSERT_EQ(100UL, s.length());
+  ASSERT_EQ(42, s.at(42).get("value").getInt());
+}
+
+TEST(ArrayStreamerTest, BatchesEmpty) {
+  std::ostringstream stream;
+  StringStreamSink sink(&stream);
+  ArrayBatchStreamer streamer(sink);
+  streamer.finish();
+  ASSERT_EQ(1UL, streamer.numArrays());
+  ASSERT_EQ(std::string("\x01"), stream.str());
+}
+
+TEST(ArrayStreamerTest, BatchesSingleArray) {
+  std::ostringstream stream;
+  StringStreamSink sink(&stream);
+  ArrayBatchStreamer streamer(sink);
+  for (int i = 0; i < 100; ++i) {
+    streamer.builder().add(Value(i));
+    streamer.next();
+  }
+  streamer.finish();
+  ASSERT_EQ(1UL, streamer.numArrays());
+
+  std::string out = stream.str();
+  Slice s(reinterpret_cast<uint8_t const*>(out.data()));
+  ASSERT_EQ(out.size(), s.byteSize());
+  ASSERT_EQ(100UL, s.length());
+}
+
+TEST(ArrayStreamerTest, Batches) {
+  std::ostringstream stream;
+  StringStreamSink sink(&stream);
+  ArrayBatchStreamer streamer(sink, 1000);
+  for (int i = 0; i < 5000; ++i) {
+    streamer.builder().add(Value(std::to_string(i)));
+    streamer.next();
+  }
+  ASSERT_EQ(5000UL, streamer.length());
+  streamer.finish();
+
+  std::size_t numArrays;
+  auto members = membersOf(stream.str(), numArrays);
+  ASSERT_LT(1UL, numArrays);
+  ASSERT_EQ(numArrays, streamer.numArrays());
+  ASSERT_EQ(5000UL, members.size());
+  for (int i = 0; i < 5000; ++i) {
+    ASSERT_EQ(std::to_string(i), members[i]);
+  }
+}
+
+TEST(ArrayStreamerTest, MemberNotClosed) {
+  std::string out;
+  StringSink sink(&out);
+  ArrayStreamer streamer(sink);
+  ASSERT_VELOCYPACK_EXCEPTION(streamer.next(),
+                              Exception::BuilderUnexpectedValue);
+  streamer.builder().openArray();
+  ASSERT_VELOCYPACK_EXCEPTION(streamer.next(), Exception::BuilderNotSealed);
+}
+
+TEST(ArrayStreamerTest, AddAfterFinish) {
+  std::string out;
+  StringSink sink(&out);
+  ArrayStreamer streamer(sink);
+  streamer.finish();
+  ASSERT_VELOCYPACK_EXCEPTION(streamer.add(Slice::nullSlice()),
+                              Exception::BuilderNeedOpenArray);
+  ASSERT_VELOCYPACK_EXCEPTION(streamer.finish(),
+                              Exception::BuilderNeedOpenArray);
+
+  std::ostringstream stream;
+  StringStreamSink streamSink(&stream);
+  ArrayBatchStreamer batches(streamSink);
+  batches.finish();
+  ASSERT_VELOCYPACK_EXCEPTION(batches.add(Slice::nullSlice()),
+                              Exception::BuilderNeedOpenArray);
+  ASSERT_VELOCYPACK_EXCEPTION(batches.finish(),
+                              Exception::BuilderNeedOpenArray);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string>
+#include <vector>
+
+#include "tests-common.h"
+
+TEST(BatchBuilderTest, Empty) {
+  BatchBuilder batch;
+  ASSERT_TRUE(batch.finish().isNone());
+  ASSERT_EQ(0UL, batch.numChunks());
+}
+
+TEST(BatchBuilderTest, ManyDocumentsShareChunks) {
+  BatchBuilder batch(&Options::Defaults, 4096);
+
+  std::vector<SharedSlice> documents;
+  for (int i = 0; i < 1000; ++i) {
+    Builder& b = batch.builder();
+    b.openObject();
+    b.add("id", Value(i));
+    b.add("name", Value("row"));
+    b.close();
+    documents.push_back(batch.finish());
+    ASSERT_TRUE(batch.builder().isEmpty());
+  }
+
+  // each document takes 19 bytes
+  ASSERT_EQ(5UL, batch.numChunks());
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(i, documents[i].slice().get("id").getInt());
+    ASSERT_EQ("row", documents[i].slice().get("name").stringView());
+  }
+  // consecutive documents are stored back to back
+  ASSERT_EQ(documents[0].slice().end(), documents[1].slice().start());
+  ASSERT_EQ(documents[0].buffer().use_count(),
+            documents[1].buffer().use_count());
+}
+
+TEST(BatchBuilderTest, DocumentsOutliveBatchBuilder) {
+  std::vector<SharedSlice> documents;
+  {
+    BatchBuilder batch;
+    for (int i = 0; i < 100; ++i) {
+      batch.builder().add(Value(std::string(10, 'a' + (i % 26))));
+      documents.push_back(batch.finish());
+    }
+  }
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(std::string(10, 'a' + (i % 26)),
+              documents[i].slice().copyString());
+  }
+}
+
+TEST(BatchBuilderTest, AddSlice) {
+  auto input = Parser::fromJson(R"([1, "foo", {"a": [1, 2, 3]}])");
+
+  BatchBuilder batch;
+  std::vector<SharedSlice> documents;
+  for (Slice member : ArrayIterator(input->slice())) {
+    documents.push_back(batch.add(member));
+  }
+  ASSERT_EQ(1UL, batch.numChunks());
+  ASSERT_EQ(3UL, documents.size());
+  ASSERT_EQ("1", documents[0].slice().toJson());
+  ASSERT_EQ(R"("foo")", documents[1].slice().toJson());
+  ASSERT_EQ(R"({"a":[1,2,3]})", documents[2].slice().toJson());
+}
+
+TEST(BatchBuilderTest, LargeDocumentGetsOwnChunk) {
+  BatchBuilder batch(&Options::Defaults, 1024);
+
+  batch.builder().add(Value(1));
+  SharedSlice small = batch.finish();
+  ASSERT_EQ(1UL, batch.numChunks());
+
+  batch.builder().add(Value(std::string(1000, 'x')));
+  SharedSlice large = batch.finish();
+  ASSERT_EQ(2UL, batch.numChunks());
+
+  // the current chunk is still used for small documents
+  batch.builder().add(Value(2));
+  SharedSlice next = batch.finish();
+  ASSERT_EQ(2UL, batch.numChunks());
+  ASSERT_EQ(small.slice().end(), next.slice().start());
+
+  ASSERT_EQ(1, small.slice().getInt());
+  ASSERT_EQ(std::string(1000, 'x'), large.slice().copyString());
+  ASSERT_EQ(2, next.slice().getInt());
+}
+
+TEST(BatchBuilderTest, FinishOpenDocument) {
+  BatchBuilder batch;
+  batch.builder().openArray();
+  ASSERT_VELOCYPACK_EXCEPTION((void)batch.finish(),
+                              Exception::BuilderNotSealed);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
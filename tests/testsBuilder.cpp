@@ -23,9 +23,12 @@
 /// @author Copyright 2015, ArangoDB GmbH, Cologne, Germany
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <array>
 #include <iostream>
+#include <limits>
 #include <ostream>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -1319,6 +1322,497 @@ TEST(BuilderTest, ObjectSorted) {
   ASSERT_EQ(0, memcmp(result, correctResult, len));
 }
 
+TEST(BuilderTest, ObjectSortedLarge) {
+  // names that share long prefixes, names that are prefixes of other
+  // names, and names that are shorter or longer than 8 bytes
+  std::vector<std::string> names;
+  for (int i = 0; i < 500; ++i) {
+    std::string const suffix = std::to_string((i * 7919) % 1000);
+    names.push_back(suffix);
+    names.push_back("metrics.latency." + suffix);
+    names.push_back("metrics.latency." + suffix + ".p99");
+  }
+  names.push_back("");
+  names.push_back(std::string("a\0b", 3));
+  names.push_back("a");
+
+  std::vector<std::string> sorted = names;
+  std::sort(sorted.begin(), sorted.end());
+
+  for (auto const* input : {&names, &sorted}) {
+    Builder b;
+    b.openObject();
+    for (std::size_t i = 0; i < input->size(); ++i) {
+      b.add((*input)[i], Value(i));
+    }
+    b.close();
+
+    Slice s = b.slice();
+    ASSERT_EQ(sorted.size(), s.length());
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+      ASSERT_EQ(sorted[i], s.keyAt(i).stringView());
+    }
+    for (std::size_t i = 0; i < input->size(); ++i) {
+      ASSERT_EQ(i, s.get((*input)[i]).getUInt());
+    }
+  }
+}
+
+TEST(BuilderTest, ObjectSortedLargeCommonPrefix) {
+  // all names share a prefix longer than 8 bytes
+  Builder b;
+  b.openObject();
+  for (int i = 99; i >= 0; --i) {
+    b.add("some.common.prefix." + std::to_string(i), Value(i));
+  }
+  b.add("some.common.prefix.", Value(-1));
+  b.close();
+
+  Slice s = b.slice();
+  ASSERT_EQ(101UL, s.length());
+  std::string last;
+  for (ValueLength i = 0; i < s.length(); ++i) {
+    std::string key = s.keyAt(i).copyString();
+    ASSERT_LT(last, key);
+    last = std::move(key);
+  }
+  ASSERT_EQ(-1, s.get("some.common.prefix.").getInt());
+  ASSERT_EQ(42, s.get("some.common.prefix.42").getInt());
+}
+
+TEST(BuilderTest, ObjectCompactUniquenessLarge) {
+  Options options;
+  options.checkAttributeUniqueness = true;
+
+  // reuses the set for the uniqueness checks of many objects
+  for (std::size_t n : {5, 100, 3000, 20}) {
+    Builder b(&options);
+    b.openObject(true);
+    for (std::size_t i = 0; i < n; ++i) {
+      b.add("key" + std::to_string(i), Value(i));
+    }
+    b.close();
+    ASSERT_EQ(n, b.slice().length());
+
+    Builder d(&options);
+    d.openObject(true);
+    for (std::size_t i = 0; i < n; ++i) {
+      d.add("key" + std::to_string(i), Value(i));
+    }
+    d.add("key" + std::to_string(n / 2), Value(n));
+    ASSERT_VELOCYPACK_EXCEPTION(d.close(), Exception::DuplicateAttributeName);
+  }
+}
+
+namespace {
+
+// checks that addArray() builds the same array as adding the values one
+// by one
+template<typename T>
+void checkAddArray(std::vector<T> const& values, Options const* options) {
+  Builder expected(options);
+  expected.openArray();
+  for (T v : values) {
+    expected.add(Value(v));
+  }
+  expected.close();
+
+  Builder actual(options);
+  uint8_t* result = actual.addArray(std::span<T const>(values));
+  ASSERT_EQ(actual.start(), result);
+  ASSERT_TRUE(actual.isClosed());
+  ASSERT_EQ(expected.size(), actual.size());
+  ASSERT_EQ(0, memcmp(expected.data(), actual.data(), actual.size()));
+}
+
+template<typename T>
+void checkAddArray(std::vector<T> const& values) {
+  for (auto padding : {Options::PaddingBehavior::Flexible,
+                       Options::PaddingBehavior::NoPadding,
+                       Options::PaddingBehavior::UsePadding}) {
+    for (bool unindexed : {false, true}) {
+      Options options;
+      options.paddingBehavior = padding;
+      options.buildUnindexedArrays = unindexed;
+      checkAddArray(values, &options);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(BuilderTest, AddArrayInts) {
+  checkAddArray<int64_t>({});
+  checkAddArray<int64_t>({42});
+  checkAddArray<int64_t>({0, 1, 2, 3});
+  checkAddArray<int64_t>({-7, -6, -1, 0, 9, 10, 127, 128, -128, -129, 32767,
+                          -32768, 32768, 2147483647LL, -2147483648LL,
+                          4294967296LL, std::numeric_limits<int64_t>::max(),
+                          std::numeric_limits<int64_t>::min()});
+
+  std::vector<int64_t> many;
+  for (int64_t i = 0; i < 100000; ++i) {
+    many.push_back((i % 2 == 0 ? i : -i) * 1237);
+  }
+  checkAddArray(many);
+}
+
+TEST(BuilderTest, AddArrayUInts) {
+  checkAddArray<uint64_t>({});
+  checkAddArray<uint64_t>({0, 9, 10, 255, 256, 65535, 65536, 4294967296ULL,
+                           std::numeric_limits<uint64_t>::max()});
+
+  std::vector<uint64_t> many;
+  for (uint64_t i = 0; i < 100000; ++i) {
+    many.push_back(i * i);
+  }
+  checkAddArray(many);
+}
+
+TEST(BuilderTest, AddArrayDoubles) {
+  checkAddArray<double>({});
+  checkAddArray<double>({0.0, -1.5, 3.14159, 1e300, -1e-300,
+                         std::numeric_limits<double>::infinity()});
+
+  std::vector<double> many;
+  for (int i = 0; i < 100000; ++i) {
+    many.push_back(i * 0.25);
+  }
+  checkAddArray(many);
+}
+
+TEST(BuilderTest, AddArrayNested) {
+  std::vector<int64_t> const values{1, -200, 30000};
+
+  Builder b;
+  b.openObject();
+  b.add("a", Value(1));
+  b.add(Value("b"));
+  b.addArray(std::span<int64_t const>(values));
+  b.add("c", Value(ValueType::Array));
+  b.addArray(std::span<int64_t const>(values));
+  b.close();
+  b.close();
+
+  ASSERT_EQ(R"({"a":1,"b":[1,-200,30000],"c":[[1,-200,30000]]})",
+            b.slice().toJson());
+
+  Builder o;
+  o.openObject();
+  ASSERT_VELOCYPACK_EXCEPTION(o.addArray(std::span<int64_t const>(values)),
+                              Exception::BuilderKeyMustBeString);
+}
+
+TEST(BuilderTest, AddObjectOfColumns) {
+  std::vector<double> const time{1.0, 2.0, 3.0};
+  std::vector<double> const value{0.5, -0.5, 1e10};
+  std::vector<std::string_view> const names{"time", "value"};
+  std::vector<std::span<double const>> const columns{time, value};
+
+  Builder b;
+  b.addObject(names, columns);
+  ASSERT_TRUE(b.isClosed());
+
+  Builder expected;
+  expected.openObject();
+  expected.add("time", Value(ValueType::Array));
+  for (double v : time) {
+    expected.add(Value(v));
+  }
+  expected.close();
+  expected.add("value", Value(ValueType::Array));
+  for (double v : value) {
+    expected.add(Value(v));
+  }
+  expected.close();
+  expected.close();
+  ASSERT_EQ(expected.size(), b.size());
+  ASSERT_EQ(0, memcmp(expected.data(), b.data(), b.size()));
+
+  std::vector<std::string_view> const oneName{"time"};
+  Builder wrong;
+  ASSERT_VELOCYPACK_EXCEPTION(wrong.addObject(oneName, columns),
+                              Exception::BuilderUnexpectedValue);
+}
+
+TEST(BuilderTest, AddObjectOfColumnsLongNames) {
+  // the names take more space than the values, so that the space reserved
+  // for the values must not be used up by the names
+  std::vector<std::string> const nameStrings{
+      std::string(300, 'a'), std::string(200, 'b'), std::string(500, 'c'),
+      std::string(130, 'd')};
+  std::vector<std::vector<double>> values;
+  std::vector<std::span<double const>> columns;
+  std::vector<std::string_view> names;
+  for (std::size_t i = 0; i < nameStrings.size(); ++i) {
+    values.push_back(std::vector<double>(i + 1, 0.25 * i));
+  }
+  for (std::size_t i = 0; i < nameStrings.size(); ++i) {
+    names.push_back(nameStrings[i]);
+    columns.push_back(values[i]);
+  }
+
+  Builder b;
+  b.addObject(names, columns);
+
+  Builder expected;
+  expected.openObject();
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    expected.add(names[i], Value(ValueType::Array));
+    for (double v : values[i]) {
+      expected.add(Value(v));
+    }
+    expected.close();
+  }
+  expected.close();
+  ASSERT_EQ(expected.size(), b.size());
+  ASSERT_EQ(0, memcmp(expected.data(), b.data(), b.size()));
+}
+
+namespace {
+
+// checks that a SplicedArray builds the same array as adding the members
+// one by one
+void checkSplicedArray(std::vector<Slice> const& members,
+                       Options const* options) {
+  Builder expected(options);
+  expected.openArray();
+  for (Slice member : members) {
+    expected.add(member);
+  }
+  expected.close();
+
+  SplicedArray const spliced(members, options);
+  ASSERT_EQ(expected.size(), spliced.byteSize());
+  ASSERT_EQ(members.size(), spliced.length());
+
+  Builder actual(options);
+  uint8_t* result = actual.add(spliced);
+  ASSERT_EQ(actual.start(), result);
+  ASSERT_TRUE(actual.isClosed());
+  ASSERT_EQ(expected.size(), actual.size());
+  ASSERT_EQ(0, memcmp(expected.data(), actual.data(), actual.size()));
+
+  std::string out;
+  StringSink sink(&out);
+  spliced.writeTo(sink);
+  ASSERT_EQ(expected.size(), out.size());
+  ASSERT_EQ(0, memcmp(expected.data(), out.data(), out.size()));
+}
+
+void checkSplicedArray(std::vector<Slice> const& members) {
+  for (auto padding : {Options::PaddingBehavior::Flexible,
+                       Options::PaddingBehavior::NoPadding,
+                       Options::PaddingBehavior::UsePadding}) {
+    for (bool unindexed : {false, true}) {
+      Options options;
+      options.paddingBehavior = padding;
+      options.buildUnindexedArrays = unindexed;
+      checkSplicedArray(members, &options);
+    }
+    Options options;
+    options.paddingBehavior = padding;
+    options.selectCompactFormat = true;
+    checkSplicedArray(members, &options);
+  }
+}
+
+}  // namespace
+
+TEST(BuilderTest, SplicedArray) {
+  std::vector<std::shared_ptr<Builder>> children;
+  for (std::string const& json : std::vector<std::string>{
+           "null", "1", "2", "\"foo\"", R"({"a":[1,2,3],"b":"bar"})", "[]",
+        std::string("\"") + std::string(300, 'x') + "\""}) {
+    children.push_back(Parser::fromJson(json));
+  }
+  auto slice = [&](std::size_t i) { return children[i]->slice(); };
+
+  checkSplicedArray({});
+  checkSplicedArray({slice(1)});
+  checkSplicedArray({slice(1), slice(2), slice(1)});
+  checkSplicedArray({slice(0), slice(3), slice(4), slice(5)});
+  checkSplicedArray({slice(4), slice(6)});
+  checkSplicedArray({Slice::noneSlice(), slice(1), slice(2)});
+  checkSplicedArray({Slice::noneSlice(), slice(3)});
+
+  std::vector<Slice> many;
+  for (std::size_t i = 0; i < 100000; ++i) {
+    many.push_back(slice(i % children.size()));
+  }
+  checkSplicedArray(many);
+  many.resize(250);
+  checkSplicedArray(many);
+}
+
+TEST(BuilderTest, SplicedArrayExactSize) {
+  auto child = Parser::fromJson(R"({"name":"some name","values":[1,2,3]})");
+  std::vector<Slice> const members(1000, child->slice());
+  SplicedArray const spliced(members);
+
+  Builder b;
+  b.add(spliced);
+  ASSERT_EQ(spliced.byteSize(), b.size());
+  ASSERT_EQ(spliced.byteSize(), b.bufferRef().capacity());
+  ASSERT_EQ(1000UL, b.slice().length());
+
+  // the members are handed out without copying them. they have equal
+  // sizes, so there is no index table
+  std::vector<uint8_t const*> pieces;
+  ValueLength total = 0;
+  spliced.forEachPiece([&](uint8_t const* data, ValueLength size) {
+    pieces.push_back(data);
+    total += size;
+  });
+  ASSERT_EQ(1001UL, pieces.size());
+  ASSERT_EQ(child->start(), pieces[1]);
+  ASSERT_EQ(child->start(), pieces[1000]);
+  ASSERT_EQ(spliced.byteSize(), total);
+}
+
+TEST(BuilderTest, SplicedArrayNested) {
+  auto a = Parser::fromJson("1");
+  auto b = Parser::fromJson(R"("foo")");
+  std::vector<Slice> const members{a->slice(), b->slice()};
+  SplicedArray const spliced(members);
+
+  Builder builder;
+  builder.openObject();
+  builder.add("a", spliced);
+  builder.add(PreparedKey("b"), spliced);
+  builder.add(Value("c"));
+  builder.add(spliced);
+  builder.add("d", Value(ValueType::Array));
+  builder.add(spliced);
+  builder.close();
+  builder.close();
+
+  ASSERT_EQ(
+      R"({"a":[1,"foo"],"b":[1,"foo"],"c":[1,"foo"],"d":[[1,"foo"]]})",
+      builder.slice().toJson());
+
+  Builder o;
+  o.openObject();
+  ASSERT_VELOCYPACK_EXCEPTION(o.add(spliced), Exception::BuilderKeyMustBeString);
+}
+
+TEST(BuilderTest, SplicedArrayCustomDisallowed) {
+  Builder custom;
+  custom.add(Slice(reinterpret_cast<uint8_t const*>("\xf0\x01")));
+  std::vector<Slice> const members{custom.slice()};
+
+  Options options;
+  options.disallowCustom = true;
+  SplicedArray const spliced(members, &options);
+
+  Builder b(&options);
+  ASSERT_VELOCYPACK_EXCEPTION(b.add(spliced),
+                              Exception::BuilderCustomDisallowed);
+}
+
+TEST(BuilderTest, SelectCompactFormat) {
+  Options options;
+  options.selectCompactFormat = true;
+
+  Builder b(&options);
+  b.openObject();
+  b.add("small", Value(ValueType::Array));
+  b.add(Value(1));
+  b.add(Value("two"));
+  b.close();
+  b.add("same", Value(ValueType::Array));
+  for (int i = 0; i < 20; ++i) {
+    b.add(Value(i % 10));
+  }
+  b.close();
+  b.add("single", Value(ValueType::Array));
+  b.add(Value("one"));
+  b.close();
+  b.add("large", Value(ValueType::Object));
+  for (int i = 0; i < 20; ++i) {
+    b.add(std::string("key") + std::to_string(i), Value(i));
+  }
+  b.close();
+  b.add("long", Value(ValueType::Array));
+  for (int i = 0; i < 20; ++i) {
+    b.add(Value(i % 2 == 0 ? "xxxx" : "yyyyy"));
+  }
+  b.close();
+  b.close();
+
+  Slice s = b.slice();
+  ASSERT_EQ(0x14, s.head());
+  ASSERT_EQ(0x13, s.get("small").head());
+  // all members have the same size
+  ASSERT_EQ(0x02, s.get("same").head());
+  ASSERT_EQ(0x02, s.get("single").head());
+  // more than 8 members, and more than 64 bytes
+  ASSERT_EQ(0x0b, s.get("large").head());
+  ASSERT_EQ(0x06, s.get("long").head());
+  ASSERT_EQ(19, s.get("large").get("key19").getInt());
+  ASSERT_EQ("yyyyy", s.get("long").at(19).stringView());
+
+  // up to 64 bytes of members are compact regardless of their number
+  Builder smallMembers(&options);
+  smallMembers.openArray();
+  for (int i = 0; i < 20; ++i) {
+    smallMembers.add(Value(i % 2 == 0 ? 1 : 1000));
+  }
+  smallMembers.close();
+  ASSERT_EQ(0x13, smallMembers.slice().head());
+
+  options.compactFormatMaxMembers = 0;
+  options.compactFormatMaxByteSize = 0;
+  Builder never(&options);
+  never.openObject();
+  never.add("a", Value(1));
+  never.add("b", Value(2));
+  never.close();
+  ASSERT_EQ(0x0b, never.slice().head());
+}
+
+TEST(BuilderTest, AccessHint) {
+  Options options;
+  options.selectCompactFormat = true;
+
+  Builder b(&options);
+  b.openArray();
+  b.openObject(Options::AccessHint::Random);
+  b.add("a", Value(1));
+  b.add("b", Value("two"));
+  b.close();
+  b.openObject(Options::AccessHint::Unknown);
+  b.add("a", Value(1));
+  b.add("b", Value("two"));
+  b.close();
+  b.openArray(Options::AccessHint::Sequential);
+  for (int i = 0; i < 100; ++i) {
+    b.add(Value(i));
+  }
+  b.close();
+  b.openArray(Options::AccessHint::Random);
+  b.add(Value(1));
+  b.add(Value("two"));
+  b.close();
+  b.close();
+
+  Slice s = b.slice();
+  ASSERT_EQ(0x0b, s.at(0).head());
+  ASSERT_EQ(0x14, s.at(1).head());
+  ASSERT_EQ(0x13, s.at(2).head());
+  ASSERT_EQ(0x06, s.at(3).head());
+
+  // the random access hint also overrides buildUnindexedArrays
+  Options unindexed;
+  unindexed.buildUnindexedArrays = true;
+  Builder u(&unindexed);
+  u.openArray(Options::AccessHint::Random);
+  u.add(Value(1));
+  u.add(Value("two"));
+  u.close();
+  ASSERT_EQ(0x06, u.slice().head());
+}
+
 TEST(BuilderTest, ObjectCompact) {
   double value = 2.3;
   Builder b;
@@ -2292,6 +2786,75 @@ TEST(BuilderTest, GetKeyCompact) {
   b.close();
 }
 
+TEST(BuilderTest, GetKeyLargeObject) {
+  Builder b;
+  b.openObject();
+  for (int i = 0; i < 200; ++i) {
+    std::string const key = "key" + std::to_string(i);
+    ASSERT_FALSE(b.hasKey(key));
+    b.add(key, Value(i));
+    ASSERT_EQ(i, b.getKey(key).getInt());
+    ASSERT_EQ(i / 2, b.getKey("key" + std::to_string(i / 2)).getInt());
+  }
+
+  // a nested Object gets its own index, and the outer one is rebuilt
+  b.add("sub", Value(ValueType::Object));
+  for (int i = 0; i < 20; ++i) {
+    b.add("sub" + std::to_string(i), Value(i));
+  }
+  ASSERT_EQ(19, b.getKey("sub19").getInt());
+  ASSERT_TRUE(b.getKey("key0").isNone());
+  b.close();
+  ASSERT_EQ(0, b.getKey("key0").getInt());
+  ASSERT_TRUE(b.getKey("sub").isObject());
+  ASSERT_TRUE(b.getKey("sub19").isNone());
+
+  // a key whose value is not written yet is not found
+  b.add(Value("pending"));
+  ASSERT_TRUE(b.getKey("pending").isNone());
+  b.add(Value("value"));
+  ASSERT_EQ("value", b.getKey("pending").stringView());
+
+  // the first of two equal names wins, as for small Objects
+  b.add("key5", Value(-5));
+  ASSERT_EQ(5, b.getKey("key5").getInt());
+  b.close();
+
+  // another Object at the same position does not see the old index
+  b.clear();
+  b.openObject();
+  for (int i = 0; i < 20; ++i) {
+    b.add("other" + std::to_string(i), Value(i));
+  }
+  ASSERT_TRUE(b.getKey("key0").isNone());
+  ASSERT_EQ(7, b.getKey("other7").getInt());
+  b.close();
+}
+
+TEST(BuilderTest, GetKeyLargeObjectTranslated) {
+  auto translator = std::make_unique<AttributeTranslator>();
+  translator->add("_key", 1);
+  translator->add("_id", 2);
+  translator->seal();
+
+  AttributeTranslatorScope scope(translator.get());
+
+  Options options;
+  options.attributeTranslator = translator.get();
+
+  Builder b(&options);
+  b.openObject();
+  b.add("_key", Value("k"));
+  b.add("_id", Value("i"));
+  for (int i = 0; i < 20; ++i) {
+    b.add("attr" + std::to_string(i), Value(i));
+  }
+  ASSERT_EQ("k", b.getKey("_key").stringView());
+  ASSERT_EQ("i", b.getKey("_id").stringView());
+  ASSERT_EQ(19, b.getKey("attr19").getInt());
+  b.close();
+}
+
 TEST(BuilderTest, IsClosedMixed) {
   Builder b;
   ASSERT_TRUE(b.isClosed());
@@ -2476,6 +3039,116 @@ TEST(BuilderTest, AttributeTranslations) {
   ASSERT_TRUE(s.hasKey("quetzal"));
 }
 
+TEST(BuilderTest, PreparedKey) {
+  PreparedKey const foo("foo");
+  PreparedKey const longName(std::string(200, 'x'));
+  ASSERT_EQ("foo", foo.name());
+  ASSERT_EQ("foo", foo.slice().stringView());
+  ASSERT_EQ(4UL, foo.size());
+  ASSERT_EQ(std::string(200, 'x'), longName.slice().copyString());
+
+  Builder expected;
+  expected.openObject();
+  expected.add("foo", Value(1));
+  expected.add(std::string(200, 'x'), Value("bar"));
+  expected.add("sub", Value(ValueType::Array));
+  expected.close();
+  expected.close();
+
+  Builder b;
+  b.openObject();
+  b.add(foo, Value(1));
+  b.add(longName, Slice(expected.slice().get(longName.name())));
+  b.add(PreparedKey("sub"), Value(ValueType::Array));
+  b.close();
+  b.close();
+
+  ASSERT_EQ(expected.size(), b.size());
+  ASSERT_EQ(0, memcmp(expected.data(), b.data(), b.size()));
+
+  Slice key = b.slice().keyAt(0);
+  ASSERT_EQ(key.hashString(), foo.hash());
+}
+
+TEST(BuilderTest, PreparedKeyErrors) {
+  PreparedKey const foo("foo");
+
+  Builder b;
+  b.openArray();
+  ASSERT_VELOCYPACK_EXCEPTION(b.add(foo, Value(1)),
+                              Exception::BuilderNeedOpenObject);
+  b.close();
+
+  Builder o;
+  o.openObject();
+  o.add(Value("bar"));
+  ASSERT_VELOCYPACK_EXCEPTION(o.add(foo, Value(1)),
+                              Exception::BuilderKeyAlreadyWritten);
+}
+
+TEST(BuilderTest, PreparedKeyTranslatorMismatch) {
+  auto translator = std::make_unique<AttributeTranslator>();
+  translator->add("foo", 1);
+  translator->seal();
+
+  Options options;
+  options.attributeTranslator = translator.get();
+
+  PreparedKey const plain("foo");
+  PreparedKey const translated("foo", &options);
+
+  Builder b(&options);
+  b.openObject();
+  ASSERT_VELOCYPACK_EXCEPTION(b.add(plain, Value(1)),
+                              Exception::BuilderUnexpectedValue);
+  b.close();
+  ASSERT_EQ(0UL, b.slice().length());
+
+  Builder o;
+  o.openObject();
+  ASSERT_VELOCYPACK_EXCEPTION(o.add(translated, Value(1)),
+                              Exception::BuilderUnexpectedValue);
+  o.add(plain, Value(2));
+  o.close();
+  ASSERT_EQ(2, o.slice().get("foo").getInt());
+}
+
+TEST(BuilderTest, PreparedKeyTranslated) {
+  auto translator = std::make_unique<AttributeTranslator>();
+  translator->add("foo", 1);
+  translator->add("bar", 2);
+  translator->seal();
+
+  AttributeTranslatorScope scope(translator.get());
+
+  Options options;
+  options.attributeTranslator = translator.get();
+
+  PreparedKey const foo("foo", &options);
+  PreparedKey const baz("baz", &options);
+  ASSERT_TRUE(foo.slice().isSmallInt());
+  ASSERT_EQ(1, foo.slice().getInt());
+  ASSERT_TRUE(baz.slice().isString());
+  ASSERT_EQ(PreparedKey("foo").hash(), foo.hash());
+
+  Builder expected(&options);
+  expected.openObject();
+  expected.add("foo", Value(1));
+  expected.add("baz", Value(2));
+  expected.close();
+
+  Builder b(&options);
+  b.openObject();
+  b.add(foo, Value(1));
+  b.add(baz, Value(2));
+  b.close();
+
+  ASSERT_EQ(expected.size(), b.size());
+  ASSERT_EQ(0, memcmp(expected.data(), b.data(), b.size()));
+  ASSERT_EQ(1, b.slice().get("foo").getInt());
+  ASSERT_EQ(2, b.slice().get("baz").getInt());
+}
+
 TEST(BuilderTest, AttributeTranslationsSorted) {
   auto translator = std::make_unique<AttributeTranslator>();
 
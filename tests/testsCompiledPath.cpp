@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string>
+
+#include "tests-common.h"
+
+TEST(CompiledPathTest, EmptyPath) {
+  ASSERT_VELOCYPACK_EXCEPTION(CompiledPath(std::vector<std::string_view>{}),
+                              Exception::InvalidAttributePath);
+}
+
+TEST(CompiledPathTest, NoObject) {
+  CompiledPath path({"a"});
+  ASSERT_VELOCYPACK_EXCEPTION(path.get(Slice::nullSlice()),
+                              Exception::InvalidValueType);
+}
+
+TEST(CompiledPathTest, SameShape) {
+  CompiledPath path({"meta", "owner", "name"});
+  for (int i = 0; i < 100; ++i) {
+    Builder b;
+    b.openObject();
+    b.add("_key", Value(std::to_string(i)));
+    b.add("meta", Value(ValueType::Object));
+    b.add("created", Value(i));
+    b.add("owner", Value(ValueType::Object));
+    b.add("id", Value(i));
+    b.add("name", Value("user" + std::to_string(i)));
+    b.close();
+    b.close();
+    b.add("value", Value(i * 2));
+    b.close();
+
+    Slice value = path.get(b.slice());
+    ASSERT_EQ("user" + std::to_string(i), value.copyString());
+    ASSERT_EQ(b.slice().get({"meta", "owner", "name"}).start(),
+              value.start());
+  }
+  // only the first lookup of each step searches
+  ASSERT_EQ(3U, path.misses());
+  ASSERT_EQ(297U, path.hits());
+}
+
+TEST(CompiledPathTest, DifferentShapes) {
+  CompiledPath path({"a", "b"});
+  for (int i = 0; i < 50; ++i) {
+    Builder b;
+    b.openObject();
+    for (int j = 0; j < i % 7; ++j) {
+      std::string key("x");
+      key += std::to_string(j);
+      b.add(key, Value(j));
+    }
+    b.add("a", Value(ValueType::Object));
+    if (i % 3 != 0) {
+      b.add("b", Value(i));
+    }
+    b.add("c", Value(i));
+    b.close();
+    b.close();
+
+    Slice value = path.get(b.slice());
+    if (i % 3 != 0) {
+      ASSERT_EQ(i, value.getInt());
+    } else {
+      ASSERT_TRUE(value.isNone());
+    }
+    ASSERT_EQ(b.slice().get({"a", "b"}).start(), value.start());
+  }
+}
+
+TEST(CompiledPathTest, NotAnObject) {
+  Builder b;
+  b.openObject();
+  b.add("a", Value(1));
+  b.add("b", Value(2));
+  b.close();
+
+  CompiledPath path({"a", "b"});
+  ASSERT_TRUE(path.get(b.slice()).isNone());
+  CompiledPath missing({"c", "d"});
+  ASSERT_TRUE(missing.get(b.slice()).isNone());
+}
+
+TEST(CompiledPathTest, CompactObjects) {
+  Options options;
+  options.buildUnindexedObjects = true;
+  options.selectCompactFormat = true;
+  Builder b(&options);
+  b.openObject();
+  b.add("a", Value(ValueType::Object));
+  b.add("b", Value(1));
+  b.add("c", Value(2));
+  b.close();
+  b.add("d", Value(3));
+  b.close();
+  ASSERT_EQ(0x14, b.slice().head());
+
+  CompiledPath path({"a", "c"});
+  ASSERT_EQ(2, path.get(b.slice()).getInt());
+  ASSERT_EQ(2, path.get(b.slice()).getInt());
+  ASSERT_EQ(0U, path.hits());
+  ASSERT_EQ(0U, path.misses());
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -65,10 +65,11 @@ static std::string readFile(std::string filename) {
   throw "cannot open input file";
 }
 
-static bool parseFile(std::string const& filename) {
+static bool parseFile(std::string const& filename,
+                      Options const* options = &Options::Defaults) {
   std::string const data = readFile(filename);
 
-  Parser parser;
+  Parser parser(options);
   try {
     parser.parse(data);
     auto builder = parser.steal();
@@ -154,6 +155,43 @@ TEST(StaticFilesTest, Fail32Json) { ASSERT_FALSE(parseFile("fail32.json")); }
 
 TEST(StaticFilesTest, Fail33Json) { ASSERT_FALSE(parseFile("fail33.json")); }
 
+TEST(StaticFilesTest, StructuralIndexSameResult) {
+  Options options;
+  options.useStructuralIndex = true;
+
+  for (auto const& filename :
+       {"api-docs.json", "commits.json", "countries.json",
+        "directory-tree.json", "doubles-small.json", "doubles.json",
+        "file-list.json", "object.json", "pass1.json", "pass2.json",
+        "pass3.json", "random1.json", "random2.json", "random3.json",
+        "sample.json", "sampleNoWhite.json", "small.json"}) {
+    std::string const data = readFile(filename);
+
+    auto expected = Parser::fromJson(data);
+    auto actual = Parser::fromJson(data, &options);
+    ASSERT_EQ(expected->size(), actual->size()) << filename;
+    ASSERT_EQ(0, memcmp(expected->data(), actual->data(), expected->size()))
+        << filename;
+  }
+}
+
+TEST(StaticFilesTest, StructuralIndexFailures) {
+  Options options;
+  options.useStructuralIndex = true;
+
+  for (auto const& filename :
+       {"fail2.json",  "fail3.json",  "fail4.json",  "fail5.json",
+        "fail6.json",  "fail7.json",  "fail8.json",  "fail9.json",
+        "fail10.json", "fail11.json", "fail12.json", "fail13.json",
+        "fail14.json", "fail15.json", "fail16.json", "fail17.json",
+        "fail19.json", "fail20.json", "fail21.json", "fail22.json",
+        "fail23.json", "fail24.json", "fail25.json", "fail26.json",
+        "fail27.json", "fail28.json", "fail29.json", "fail30.json",
+        "fail31.json", "fail32.json", "fail33.json"}) {
+    ASSERT_FALSE(parseFile(filename, &options)) << filename;
+  }
+}
+
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
 
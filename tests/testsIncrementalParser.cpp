@@ -0,0 +1,203 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+/// @author Copyright 2015, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+
+#include "tests-common.h"
+
+static void feedChunks(IncrementalParser& parser, std::string const& value,
+                       std::size_t chunkSize) {
+  for (std::size_t i = 0; i < value.size(); i += chunkSize) {
+    parser.feed(value.substr(i, chunkSize));
+  }
+  parser.finish();
+}
+
+static void checkChunked(std::string const& value,
+                         Options const* options = &Options::Defaults) {
+  std::shared_ptr<Builder> expected = Parser::fromJson(value, options);
+
+  for (std::size_t chunkSize = 1; chunkSize <= value.size() + 1; ++chunkSize) {
+    IncrementalParser parser(options);
+    feedChunks(parser, value, chunkSize);
+    ASSERT_TRUE(parser.isComplete());
+
+    Builder const& actual = parser.builder();
+    ASSERT_EQ(expected->size(), actual.size());
+    ASSERT_EQ(0, memcmp(expected->data(), actual.data(), actual.size()));
+  }
+}
+
+TEST(IncrementalParserTest, Scalars) {
+  checkChunked("null");
+  checkChunked("true");
+  checkChunked(" false ");
+  checkChunked("0");
+  checkChunked("-12345678901234567890");
+  checkChunked("18446744073709551615");
+  checkChunked("-1.25e-7");
+  checkChunked("\"\"");
+  checkChunked("\"foo bar\"");
+}
+
+TEST(IncrementalParserTest, Strings) {
+  checkChunked("\"der\\thund\\nging\\rin\\fden\\\\wald\\\"und\\b\\nden'fux\"");
+  checkChunked("\"\\\\\"");
+  checkChunked("\"\\\\\\\\\\\"\\\\\"");
+  checkChunked("\"\\u00e4\\ud83d\\ude00 \xc3\xa4\"");
+  checkChunked("\"" + std::string(300, 'x') + "\\\"" + std::string(200, 'y') +
+               "\"");
+}
+
+TEST(IncrementalParserTest, Compounds) {
+  checkChunked("[]");
+  checkChunked("{}");
+  checkChunked(" [ 1 , 2.5 , \"three\" , [ ] , { } , true , null ] ");
+  checkChunked("{\"a\":1,\"b\":[1,2,{\"c\":\"d\"}],\"e\":{\"f\":{}},\"g\":-0}");
+  checkChunked(
+      "{\"a\\\"b\" : \"c\\\\\" , \"\\u0064\" : [\"e\",\"f\\\"\",123456789012] }");
+  checkChunked("[[[[[[[[[[1]]]]]]]]]]");
+}
+
+TEST(IncrementalParserTest, Options) {
+  Options options;
+  options.validateUtf8Strings = true;
+  options.buildUnindexedArrays = true;
+  options.buildUnindexedObjects = true;
+  checkChunked("{\"foo\":[1,2,3],\"bar\":{\"baz\":\"\xc3\xa4\"}}", &options);
+
+  std::unique_ptr<AttributeTranslator> translator(new AttributeTranslator);
+  translator->add("foo", 1);
+  translator->add("bar", 2);
+  translator->seal();
+  AttributeTranslatorScope scope(translator.get());
+
+  Options translateOptions;
+  translateOptions.attributeTranslator = translator.get();
+  checkChunked("{\"foo\":{\"bar\":1,\"baz\":2},\"qux\":\"foo\"}",
+               &translateOptions);
+}
+
+TEST(IncrementalParserTest, Completeness) {
+  IncrementalParser parser;
+  ASSERT_FALSE(parser.feed("{\"foo\":"));
+  ASSERT_FALSE(parser.isComplete());
+  ASSERT_FALSE(parser.feed("[1,2"));
+  ASSERT_FALSE(parser.feed("]"));
+  ASSERT_TRUE(parser.feed("}"));
+  ASSERT_TRUE(parser.isComplete());
+  ASSERT_TRUE(parser.feed("  \n"));
+  parser.finish();
+
+  Slice s = parser.builder().slice();
+  ASSERT_EQ(2UL, s.get("foo").length());
+
+  // a number is only complete when followed by whitespace or at the end
+  parser.reset();
+  ASSERT_FALSE(parser.feed("12"));
+  ASSERT_FALSE(parser.feed("34"));
+  parser.finish();
+  ASSERT_TRUE(parser.isComplete());
+  ASSERT_EQ(1234UL, parser.builder().slice().getUInt());
+
+  parser.reset();
+  ASSERT_FALSE(parser.feed("-5"));
+  ASSERT_TRUE(parser.feed(" "));
+  ASSERT_EQ(-5, parser.builder().slice().getInt());
+}
+
+TEST(IncrementalParserTest, Errors) {
+  for (std::string const value :
+       {"", " ", "[", "[1,]", "[1 2]", "[1x]", "truex", "[nul]", "{\"a\" 1}",
+        "{\"a\":}", "{1:2}", "\"abc", "[\"abc]", "\"\\x\"", "1 2", "[] x",
+        "{\"a\":1", "-", "]"}) {
+    for (std::size_t chunkSize = 1; chunkSize <= value.size() + 1;
+         ++chunkSize) {
+      IncrementalParser parser;
+      ASSERT_VELOCYPACK_EXCEPTION(feedChunks(parser, value, chunkSize),
+                                  Exception::ParseError);
+    }
+  }
+}
+
+TEST(IncrementalParserTest, ErrorPosition) {
+  IncrementalParser parser;
+  parser.feed("[1,2,");
+  ASSERT_VELOCYPACK_EXCEPTION(parser.feed(" 3 ]]"), Exception::ParseError);
+  ASSERT_EQ(9UL, parser.errorPos());
+
+  parser.reset();
+  parser.feed("[1,2,3]");
+  ASSERT_TRUE(parser.isComplete());
+}
+
+TEST(IncrementalParserTest, NestingLimit) {
+  Options options;
+  options.nestingLimit = 5;
+
+  IncrementalParser parser(&options);
+  parser.feed("[[[[");
+  ASSERT_VELOCYPACK_EXCEPTION(parser.feed("["), Exception::TooDeepNesting);
+}
+
+TEST(IncrementalParserTest, KeepTopLevelOpen) {
+  Options options;
+  options.keepTopLevelOpen = true;
+
+  IncrementalParser parser(&options);
+  parser.feed("{\"foo\":1,");
+  ASSERT_TRUE(parser.feed("\"bar\":[2]}"));
+  parser.finish();
+
+  std::shared_ptr<Builder> b = parser.steal();
+  ASSERT_FALSE(b->isClosed());
+  b->close();
+  ASSERT_EQ(1UL, b->slice().get("foo").getUInt());
+  ASSERT_EQ(2UL, b->slice().get("bar").at(0).getUInt());
+}
+
+TEST(IncrementalParserTest, UseBuilderOnStackForArrayValue) {
+  Builder builder;
+  builder.openArray();
+  {
+    Options options;
+    options.clearBuilderBeforeParse = false;
+    IncrementalParser parser(builder, &options);
+    parser.feed("[1,");
+    parser.feed("2]");
+    parser.finish();
+  }
+  builder.close();
+
+  Slice s = builder.slice();
+  ASSERT_EQ(1UL, s.length());
+  ASSERT_EQ(2UL, s.at(0).length());
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
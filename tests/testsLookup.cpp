@@ -1053,6 +1053,128 @@ TEST(LookupTest, ValueAtObjectEmpty) {
   ASSERT_VELOCYPACK_EXCEPTION(s.valueAt(1), Exception::IndexOutOfBounds);
 }
 
+TEST(LookupTest, GetMany) {
+  std::vector<std::string_view> const attributes = {"z", "b", "qux", "a",
+                                                    "b", "missing", ""};
+  for (int n : {0, 1, 3, 20, 100}) {
+    for (bool unindexed : {false, true}) {
+      for (bool compact : {false, true}) {
+        Options options;
+        options.buildUnindexedObjects = unindexed;
+        options.selectCompactFormat = compact;
+        Builder b(&options);
+        b.openObject();
+        for (std::string key : {"a", "b", "qux", "z"}) {
+          if (n > 0) {
+            b.add(key, Value(key + "-value"));
+          }
+        }
+        for (int i = 0; i < n; ++i) {
+          b.add("key" + std::to_string(i), Value(i));
+        }
+        b.close();
+        Slice s = b.slice();
+
+        std::vector<Slice> values(attributes.size());
+        s.getMany(attributes, values);
+        for (std::size_t i = 0; i < attributes.size(); ++i) {
+          ASSERT_EQ(s.get(attributes[i]).start(), values[i].start());
+          ASSERT_EQ(s.get(attributes[i]).isNone(), values[i].isNone());
+        }
+        if (n > 0) {
+          ASSERT_EQ("z-value", values[0].stringView());
+          ASSERT_EQ("b-value", values[4].stringView());
+          ASSERT_TRUE(values[5].isNone());
+        }
+
+        std::vector<std::string> keys;
+        for (int i = n - 1; i >= 0; i -= 2) {
+          keys.push_back("key" + std::to_string(i));
+        }
+        std::vector<std::string_view> many(keys.begin(), keys.end());
+        values.resize(many.size());
+        s.getMany(many, values);
+        for (std::size_t i = 0; i < many.size(); ++i) {
+          ASSERT_EQ(s.get(many[i]).start(), values[i].start());
+        }
+      }
+    }
+  }
+}
+
+TEST(LookupTest, GetManyErrors) {
+  Builder b;
+  b.openObject();
+  b.add("a", Value(1));
+  b.close();
+
+  std::vector<std::string_view> attributes = {"a", "b"};
+  std::vector<Slice> values(1);
+  ASSERT_VELOCYPACK_EXCEPTION(b.slice().getMany(attributes, values),
+                              Exception::IndexOutOfBounds);
+  values.resize(2);
+  ASSERT_VELOCYPACK_EXCEPTION(Slice::nullSlice().getMany(attributes, values),
+                              Exception::InvalidValueType);
+}
+
+TEST(LookupTest, LookupCompactObjectKeyLengths) {
+  Options options;
+  options.buildUnindexedObjects = true;
+  Builder b(&options);
+  b.openObject();
+  b.add("a", Value(1));
+  b.add("b", Value(2));
+  b.add("ab", Value(3));
+  b.add(std::string(127, 'c'), Value(4));
+  b.add(std::string(300, 'd'), Value(5));
+  b.close();
+  Slice s = b.slice();
+  ASSERT_EQ(0x14, s.head());
+
+  ASSERT_EQ(1, s.get("a").getInt());
+  ASSERT_EQ(2, s.get("b").getInt());
+  ASSERT_EQ(3, s.get("ab").getInt());
+  ASSERT_EQ(4, s.get(std::string(127, 'c')).getInt());
+  ASSERT_EQ(5, s.get(std::string(300, 'd')).getInt());
+  ASSERT_TRUE(s.get("ba").isNone());
+  ASSERT_TRUE(s.get(std::string(126, 'c')).isNone());
+  ASSERT_TRUE(s.get(std::string(300, 'e')).isNone());
+}
+
+TEST(LookupTest, LookupTranslatedKeys) {
+  auto translator = std::make_unique<AttributeTranslator>();
+  translator->add("foo", 1);
+  translator->add("quux", 2);
+  translator->seal();
+
+  AttributeTranslatorScope scope(translator.get());
+
+  for (bool compact : {false, true}) {
+    Options options;
+    options.attributeTranslator = translator.get();
+    options.buildUnindexedObjects = compact;
+    Builder b(&options);
+    b.openObject();
+    for (int i = 0; i < 10; ++i) {
+      std::string key("k");
+      key += std::to_string(i);
+      b.add(key, Value(i));
+    }
+    b.add("foo", Value(10));
+    b.add("quux", Value(11));
+    b.add("bar", Value(12));
+    b.close();
+
+    Slice s = b.slice();
+    ASSERT_EQ(compact, s.head() == 0x14);
+    ASSERT_EQ(10, s.get("foo").getInt());
+    ASSERT_EQ(11, s.get("quux").getInt());
+    ASSERT_EQ(12, s.get("bar").getInt());
+    ASSERT_EQ(7, s.get("k7").getInt());
+    ASSERT_TRUE(s.get("baz").isNone());
+  }
+}
+
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
 
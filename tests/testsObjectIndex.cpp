@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string>
+
+#include "tests-common.h"
+
+namespace {
+
+Builder makeObject(int n, bool sorted) {
+  Options options;
+  options.buildUnindexedObjects = !sorted;
+  Builder b(&options);
+  b.openObject();
+  for (int i = 0; i < n; ++i) {
+    b.add("key" + std::to_string(i), Value(i));
+  }
+  b.close();
+  return b;
+}
+
+}  // namespace
+
+TEST(ObjectIndexTest, Empty) {
+  Builder b;
+  b.openObject();
+  b.close();
+  ObjectIndex index(b.slice());
+  ASSERT_EQ(0UL, index.size());
+  ASSERT_TRUE(index.get("foo").isNone());
+  ASSERT_FALSE(index.hasKey(""));
+}
+
+TEST(ObjectIndexTest, NoObject) {
+  Builder b;
+  b.openArray();
+  b.close();
+  ASSERT_VELOCYPACK_EXCEPTION(ObjectIndex(b.slice()),
+                              Exception::InvalidValueType);
+}
+
+TEST(ObjectIndexTest, Lookups) {
+  for (bool sorted : {true, false}) {
+    Builder b = makeObject(5000, sorted);
+    ObjectIndex index(b.slice());
+    ASSERT_EQ(5000UL, index.size());
+    ASSERT_EQ(b.slice().start(), index.slice().start());
+    for (int i = 0; i < 5000; ++i) {
+      std::string key = "key" + std::to_string(i);
+      HashedStringRef name(key.data(), static_cast<uint32_t>(key.size()));
+      Slice value = index.get(name);
+      ASSERT_TRUE(value.isInteger());
+      ASSERT_EQ(i, value.getInt());
+      ASSERT_EQ(b.slice().get(key).start(), value.start());
+      ASSERT_TRUE(index.hasKey(key));
+    }
+    ASSERT_TRUE(index.get("key5000").isNone());
+    ASSERT_TRUE(index.get("key").isNone());
+    ASSERT_TRUE(index.get("").isNone());
+  }
+}
+
+TEST(ObjectIndexTest, DuplicateKeys) {
+  Options options;
+  options.buildUnindexedObjects = true;
+  Builder b(&options);
+  b.openObject();
+  b.add("a", Value(1));
+  b.add("b", Value(2));
+  b.add("a", Value(3));
+  b.close();
+  ObjectIndex index(b.slice());
+  ASSERT_EQ(2UL, index.size());
+  ASSERT_EQ(1, index.get("a").getInt());
+  ASSERT_EQ(2, index.get("b").getInt());
+}
+
+TEST(ObjectIndexTest, TranslatedKeys) {
+  auto translator = std::make_unique<AttributeTranslator>();
+  translator->add("foo", 1);
+  translator->add("bar", 2);
+  translator->seal();
+
+  AttributeTranslatorScope scope(translator.get());
+
+  Options options;
+  options.attributeTranslator = translator.get();
+  Builder b(&options);
+  b.openObject();
+  b.add("foo", Value(1));
+  b.add("bar", Value(2));
+  b.add("baz", Value(3));
+  b.close();
+
+  ObjectIndex index(b.slice());
+  ASSERT_EQ(3UL, index.size());
+  ASSERT_EQ(1, index.get("foo").getInt());
+  ASSERT_EQ(2, index.get("bar").getInt());
+  ASSERT_EQ(3, index.get("baz").getInt());
+  ASSERT_TRUE(index.get("qux").isNone());
+}
+
+TEST(ObjectIndexTest, SharedSlice) {
+  ObjectIndex index = [] {
+    Builder b = makeObject(100, true);
+    return ObjectIndex(std::move(b).sharedSlice());
+  }();
+  ASSERT_EQ(100UL, index.size());
+  ASSERT_EQ(42, index.get("key42").getInt());
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string>
+
+#include "tests-common.h"
+
+namespace {
+
+Builder makeCompact(bool isArray, int n) {
+  Options options;
+  options.buildUnindexedArrays = true;
+  options.buildUnindexedObjects = true;
+  Builder b(&options);
+  if (isArray) {
+    b.openArray();
+    for (int i = 0; i < n; ++i) {
+      // members of different sizes
+      b.add(Value(std::string(i % 10, 'x') + std::to_string(i)));
+    }
+  } else {
+    b.openObject();
+    for (int i = n - 1; i >= 0; --i) {
+      b.add("key" + std::to_string(i), Value(std::string(i % 10, 'x')));
+    }
+  }
+  b.close();
+  return b;
+}
+
+}  // namespace
+
+TEST(OffsetCacheTest, NoCompound) {
+  ASSERT_VELOCYPACK_EXCEPTION(OffsetCache(Slice::nullSlice()),
+                              Exception::InvalidValueType);
+}
+
+TEST(OffsetCacheTest, CompactArray) {
+  Builder b = makeCompact(true, 1000);
+  Slice s = b.slice();
+  ASSERT_EQ(0x13, s.head());
+
+  OffsetCache cache(s);
+  ASSERT_EQ(1000UL, cache.length());
+  // access from the back first, then everything in random order
+  ASSERT_EQ(s.at(999).start(), cache.at(999).start());
+  for (int i = 0; i < 1000; ++i) {
+    int index = (i * 337) % 1000;
+    ASSERT_EQ(s.at(index).start(), cache[index].start());
+  }
+  ASSERT_VELOCYPACK_EXCEPTION(cache.at(1000), Exception::IndexOutOfBounds);
+  ASSERT_VELOCYPACK_EXCEPTION(cache.get("foo"), Exception::InvalidValueType);
+  ASSERT_VELOCYPACK_EXCEPTION(cache.keyAt(0), Exception::InvalidValueType);
+}
+
+TEST(OffsetCacheTest, CompactObject) {
+  Builder b = makeCompact(false, 500);
+  Slice s = b.slice();
+  ASSERT_EQ(0x14, s.head());
+
+  OffsetCache cache(s);
+  ASSERT_EQ(500UL, cache.length());
+  for (int i = 0; i < 500; ++i) {
+    int index = (i * 211) % 500;
+    ASSERT_EQ(s.keyAt(index).stringView(), cache.keyAt(index).stringView());
+    ASSERT_EQ(s.valueAt(index).start(), cache.valueAt(index).start());
+  }
+  for (int i = 0; i < 500; ++i) {
+    std::string key = "key" + std::to_string(i);
+    ASSERT_EQ(s.get(key).start(), cache.get(key).start());
+  }
+  ASSERT_TRUE(cache.get("key500").isNone());
+  ASSERT_TRUE(cache.get("").isNone());
+  ASSERT_TRUE(cache.get("zzz").isNone());
+  ASSERT_VELOCYPACK_EXCEPTION(cache.at(0), Exception::InvalidValueType);
+  ASSERT_VELOCYPACK_EXCEPTION(cache.keyAt(500), Exception::IndexOutOfBounds);
+}
+
+TEST(OffsetCacheTest, DuplicateKeys) {
+  Options options;
+  options.buildUnindexedObjects = true;
+  Builder b(&options);
+  b.openObject();
+  b.add("b", Value(1));
+  b.add("a", Value(2));
+  b.add("b", Value(3));
+  b.close();
+
+  OffsetCache cache(b.slice());
+  ASSERT_EQ(b.slice().get("b").start(), cache.get("b").start());
+  ASSERT_EQ(1, cache.get("b").getInt());
+  ASSERT_EQ(2, cache.get("a").getInt());
+}
+
+TEST(OffsetCacheTest, IndexedValues) {
+  Builder b;
+  b.openObject();
+  b.add("a", Value(1));
+  b.add("b", Value(ValueType::Array));
+  b.add(Value(1));
+  b.add(Value("foo"));
+  b.close();
+  b.close();
+
+  OffsetCache object(b.slice());
+  ASSERT_EQ(2UL, object.length());
+  ASSERT_EQ(1, object.get("a").getInt());
+  ASSERT_EQ("b", object.keyAt(1).stringView());
+
+  OffsetCache array(b.slice().get("b"));
+  ASSERT_EQ(2UL, array.length());
+  ASSERT_EQ("foo", array.at(1).stringView());
+}
+
+TEST(OffsetCacheTest, SharedSlice) {
+  OffsetCache cache = [] {
+    Builder b = makeCompact(true, 100);
+    return OffsetCache(std::move(b).sharedSlice());
+  }();
+  ASSERT_EQ(100UL, cache.length());
+  ASSERT_EQ("xxxxxxx57", cache.at(57).stringView());
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
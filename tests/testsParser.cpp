@@ -24,6 +24,9 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <array>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -35,6 +38,8 @@ namespace velocypack {
 
 extern void enableNativeStringFunctions();
 extern void enableBuiltinStringFunctions();
+extern bool enableSSE42StringFunctions();
+extern bool enableAVX2StringFunctions();
 
 }  // namespace velocypack
 }  // namespace arangodb
@@ -439,6 +444,65 @@ TEST(ParserTest, UIntMaxPlusOne) {
   ASSERT_DOUBLE_EQ(18446744073709551616., s.getDouble());
 }
 
+TEST(ParserTest, IntAllLengths) {
+  // numbers of all lengths, so that the digits end at every position
+  // within the 8-byte chunks used for scanning
+  uint64_t value = 0;
+  for (int digits = 1; digits <= 19; ++digits) {
+    value = value * 10 + (digits % 10);
+    std::string const number = std::to_string(value);
+
+    for (std::string const& json :
+         {number, number + " ", "[" + number + "]", "[" + number + ",1]"}) {
+      std::shared_ptr<Builder> builder = Parser::fromJson(json);
+      Slice s(builder->start());
+      if (s.isArray()) {
+        s = s.at(0);
+      }
+      ASSERT_EQ(value, s.getNumber<uint64_t>()) << json;
+    }
+
+    std::shared_ptr<Builder> builder = Parser::fromJson("-" + number);
+    Slice s(builder->start());
+    ASSERT_EQ(-static_cast<int64_t>(value), s.getNumber<int64_t>());
+  }
+}
+
+TEST(ParserTest, IntAroundUIntMax) {
+  std::string const value(
+      "[18446744073709551609,18446744073709551610,18446744073709551615,"
+      "18446744073709551616,18446744073709551619,18446744073709551620]");
+
+  std::shared_ptr<Builder> builder = Parser::fromJson(value);
+  Slice s(builder->start());
+  ASSERT_EQ(18446744073709551609ULL, s.at(0).getUInt());
+  ASSERT_EQ(18446744073709551610ULL, s.at(1).getUInt());
+  ASSERT_EQ(18446744073709551615ULL, s.at(2).getUInt());
+  ASSERT_TRUE(s.at(3).isDouble());
+  ASSERT_EQ(18446744073709551616., s.at(3).getDouble());
+  ASSERT_TRUE(s.at(4).isDouble());
+  ASSERT_EQ(18446744073709551619., s.at(4).getDouble());
+  ASSERT_TRUE(s.at(5).isDouble());
+  ASSERT_EQ(18446744073709551620., s.at(5).getDouble());
+}
+
+TEST(ParserTest, DoubleFractionAllLengths) {
+  std::string fraction;
+  for (int digits = 1; digits <= 24; ++digits) {
+    fraction.push_back('0' + (digits % 10));
+    std::string const json = "[1." + fraction + "," + "-0." + fraction + "]";
+
+    std::shared_ptr<Builder> builder = Parser::fromJson(json);
+    Slice s(builder->start());
+    ASSERT_EQ(std::strtod(("1." + fraction).c_str(), nullptr),
+              s.at(0).getDouble())
+        << json;
+    ASSERT_EQ(std::strtod(("-0." + fraction).c_str(), nullptr),
+              s.at(1).getDouble())
+        << json;
+  }
+}
+
 TEST(ParserTest, Double1) {
   std::string const value("1.0124");
 
@@ -732,6 +796,77 @@ TEST(ParserTest, DoublePlusInf) {
   ASSERT_VELOCYPACK_EXCEPTION(parser.parse(value), Exception::NumberOutOfRange);
 }
 
+TEST(ParserTest, DoubleUnderflow) {
+  std::string const value("[1e-400,-1e-400,0.0001e-321]");
+
+  std::shared_ptr<Builder> builder = Parser::fromJson(value);
+  Slice s(builder->start());
+  ASSERT_EQ(0.0, s.at(0).getDouble());
+  ASSERT_EQ(0.0, s.at(1).getDouble());
+  ASSERT_TRUE(std::signbit(s.at(1).getDouble()));
+  ASSERT_EQ(0.0, s.at(2).getDouble());
+}
+
+TEST(ParserTest, DoubleSubnormal) {
+  std::string const value("[4.9e-324,2.2250738585072011e-308]");
+
+  std::shared_ptr<Builder> builder = Parser::fromJson(value);
+  Slice s(builder->start());
+  ASSERT_EQ(std::numeric_limits<double>::denorm_min(), s.at(0).getDouble());
+  ASSERT_EQ(2.2250738585072011e-308, s.at(1).getDouble());
+}
+
+TEST(ParserTest, DoubleLimits) {
+  std::string const value(
+      "[1.7976931348623157e308,-1.7976931348623157e308,"
+      "2.2250738585072014e-308]");
+
+  std::shared_ptr<Builder> builder = Parser::fromJson(value);
+  Slice s(builder->start());
+  ASSERT_EQ(std::numeric_limits<double>::max(), s.at(0).getDouble());
+  ASSERT_EQ(std::numeric_limits<double>::lowest(), s.at(1).getDouble());
+  ASSERT_EQ(std::numeric_limits<double>::min(), s.at(2).getDouble());
+}
+
+TEST(ParserTest, DoubleCorrectlyRounded) {
+  // all of these values must be converted to the nearest double
+  std::array<std::pair<char const*, double>, 9> const values = {{
+      {"0.1", 0.1},
+      {"0.3", 0.3},
+      {"0.30000000000000004", 0.30000000000000004},
+      {"1e23", 1e23},
+      {"9007199254740993.0", 9007199254740993.0},
+      {"7.3177701707893310e+15", 7.3177701707893310e+15},
+      {"8.988465674311580536566680e307", 8.988465674311580536566680e307},
+      {"2.4703282292062328e-324", 4.9406564584124654e-324},
+      {"1.00000000000000011102230246251565404236316680908203125",
+       1.00000000000000011102230246251565404236316680908203125},
+  }};
+
+  for (auto const& it : values) {
+    std::shared_ptr<Builder> builder = Parser::fromJson(std::string(it.first));
+    Slice s(builder->start());
+    ASSERT_TRUE(s.isDouble());
+    ASSERT_EQ(it.second, s.getDouble()) << it.first;
+  }
+}
+
+TEST(ParserTest, DoubleManyDigits) {
+  std::string const value(
+      "[0.1000000000000000055511151231257827021181583404541015625,"
+      "123456789012345678901234567890,"
+      "123456789012345678901234567890.123456789,"
+      "-0.00000000000000000000000000000000000000001234567890123456789012]");
+
+  std::shared_ptr<Builder> builder = Parser::fromJson(value);
+  Slice s(builder->start());
+  ASSERT_EQ(0.1, s.at(0).getDouble());
+  ASSERT_EQ(123456789012345678901234567890., s.at(1).getDouble());
+  ASSERT_EQ(123456789012345678901234567890., s.at(2).getDouble());
+  ASSERT_EQ(-0.00000000000000000000000000000000000000001234567890123456789012,
+            s.at(3).getDouble());
+}
+
 TEST(ParserTest, Empty) {
   std::string const value("");
 
@@ -2660,6 +2795,82 @@ TEST(ParserTest, UseNonSSEWhitespaceCheck) {
   ASSERT_EQ(value.substr(1, value.size() - 2), s.copyString());
 }
 
+// parses all values and validates them as VPack with all kinds of
+// options, and returns all results and errors
+static std::vector<std::string> parseWithStringFunctions(
+    std::vector<std::string> const& values) {
+  std::vector<std::string> results;
+  for (bool validateUtf8 : {false, true}) {
+    for (bool structuralIndex : {false, true}) {
+      Options options;
+      options.validateUtf8Strings = validateUtf8;
+      options.useStructuralIndex = structuralIndex;
+      for (auto const& value : values) {
+        Parser parser(&options);
+        try {
+          parser.parse(value);
+          results.emplace_back(
+              reinterpret_cast<char const*>(parser.builder().data()),
+              parser.builder().size());
+        } catch (Exception const& ex) {
+          results.emplace_back(std::string(ex.what()) + " at " +
+                               std::to_string(parser.errorPos()));
+        }
+      }
+    }
+
+    Options options;
+    options.validateUtf8Strings = true;
+    Validator validator(&options);
+    for (auto const& value : values) {
+      Builder b;
+      b.add(Value(value));
+      try {
+        results.emplace_back(validator.validate(b.data(), b.size())
+                                 ? "valid"
+                                 : "invalid");
+      } catch (Exception const& ex) {
+        results.emplace_back(ex.what());
+      }
+    }
+  }
+  return results;
+}
+
+TEST(ParserTest, StringFunctionVariants) {
+  // special characters at all positions relative to the 16 and 32 byte
+  // blocks of the vectorized implementations
+  std::vector<std::string> values;
+  for (std::size_t i = 0; i < 70; ++i) {
+    std::string const padding(i, 'x');
+    values.push_back("\"" + padding + "\"");
+    values.push_back("\"" + padding + "\\n" + padding + "\"");
+    values.push_back("\"" + padding + "\\\"" + padding + "\"");
+    values.push_back("\"" + padding + "\xc3\xa4" + padding + "\"");
+    values.push_back("\"" + padding + "\xe2\x82\xac" + padding + "\"");
+    values.push_back("\"" + padding + "\x01" + padding + "\"");
+    values.push_back("\"" + padding + "\xff" + padding + "\"");
+    values.push_back("\"" + padding + "\xc3" + "\"");
+    values.push_back(std::string(i, ' ') + "[" + std::string(i, '\n') + "1" +
+                     std::string(i, '\t') + ",{\"" + padding + "\":\r" +
+                     std::string(i, ' ') + "\"[]{}:,\"}]" +
+                     std::string(i, '\r'));
+  }
+
+  enableBuiltinStringFunctions();
+  std::vector<std::string> const expected = parseWithStringFunctions(values);
+
+  if (enableSSE42StringFunctions()) {
+    ASSERT_EQ(expected, parseWithStringFunctions(values));
+  }
+  enableBuiltinStringFunctions();
+  if (enableAVX2StringFunctions()) {
+    ASSERT_EQ(expected, parseWithStringFunctions(values));
+  }
+  enableNativeStringFunctions();
+  ASSERT_EQ(expected, parseWithStringFunctions(values));
+}
+
 TEST(ParserTest, ClearBuilderOption) {
   Options options;
   options.clearBuilderBeforeParse = false;
@@ -2717,6 +2928,472 @@ TEST(ParserTest, UseBuilderOnStackOptionsNullPtr) {
   delete parser;
 }
 
+static void checkStructuralIndex(std::string const& value,
+                                 bool multi = false) {
+  Options options;
+  options.useStructuralIndex = true;
+
+  Parser expected;
+  expected.parse(value, multi);
+  Parser actual(&options);
+  actual.parse(value, multi);
+  ASSERT_EQ(expected.builder().size(), actual.builder().size()) << value;
+  ASSERT_EQ(0, memcmp(expected.builder().data(), actual.builder().data(),
+                      expected.builder().size()))
+      << value;
+}
+
+TEST(ParserTest, StructuralIndexValues) {
+  for (bool native : {false, true}) {
+    if (native) {
+      enableNativeStringFunctions();
+    } else {
+      enableBuiltinStringFunctions();
+    }
+
+    checkStructuralIndex("null");
+    checkStructuralIndex(" true ");
+    checkStructuralIndex("false");
+    checkStructuralIndex("-12.5e3");
+    checkStructuralIndex("\"\"");
+    checkStructuralIndex("[]");
+    checkStructuralIndex("{}");
+    checkStructuralIndex(" [ 1 , \"a\" ,{ \"b\" :[null,true,false] } ] ");
+    checkStructuralIndex("{\"a\\\"b\":\"\\u00e4\\n\",\"c\":\"x\\\\\"}");
+    checkStructuralIndex("1 2 [3] {\"a\":4}\"b\"", true);
+
+    // escape sequences and string boundaries at all positions relative
+    // to the 64 byte blocks of the index
+    for (std::size_t i = 0; i < 140; ++i) {
+      std::string padding(i, 'x');
+      checkStructuralIndex("[\"" + padding + "\\\"\", \"\\\\\"]");
+      checkStructuralIndex("[\"" + padding + "\",\"\\\\\\\\\",1]");
+      std::string whitespace(i, ' ');
+      checkStructuralIndex("[" + whitespace + "123,\"" + padding + "\"]");
+    }
+    // runs of backslashes crossing block boundaries
+    for (std::size_t i = 0; i < 140; ++i) {
+      std::string backslashes(2 * i, '\\');
+      checkStructuralIndex("[\"" + backslashes + "\", \"" + backslashes +
+                           "\\\"\"]");
+    }
+  }
+  enableNativeStringFunctions();
+}
+
+TEST(ParserTest, StructuralIndexErrors) {
+  Options options;
+  options.useStructuralIndex = true;
+
+  for (std::string const value :
+       {"", " ", "[", "]", "{", "[1,]", "[1 2]", "[1x]", "truex", "[nul]",
+        "{\"a\" 1}", "{\"a\":}", "{1:2}", "\"abc", "[\"abc]", "\"\\x\"", "1 2",
+        "[] x", "\"a\"1"}) {
+    Parser parser(&options);
+    ASSERT_VELOCYPACK_EXCEPTION(parser.parse(value), Exception::ParseError);
+    Parser expected;
+    ASSERT_VELOCYPACK_EXCEPTION(expected.parse(value), Exception::ParseError);
+  }
+
+  Parser parser(&options);
+  ASSERT_VELOCYPACK_EXCEPTION(parser.parse("\"a\nb\""),
+                              Exception::UnexpectedControlCharacter);
+
+  options.validateUtf8Strings = true;
+  ASSERT_VELOCYPACK_EXCEPTION(parser.parse("\"\xff\""),
+                              Exception::InvalidUtf8Sequence);
+}
+
+TEST(ParserTest, StructuralIndexKeepTopLevelOpen) {
+  Options options;
+  options.useStructuralIndex = true;
+  options.keepTopLevelOpen = true;
+  std::shared_ptr<Builder> b =
+      Parser::fromJson("{\"foo\":1,\"bar\":[2]}", &options);
+  ASSERT_FALSE(b->isClosed());
+  b->close();
+
+  Slice s(b->start());
+  ASSERT_EQ(1UL, s.get("foo").getUInt());
+  ASSERT_EQ(2UL, s.get("bar").at(0).getUInt());
+}
+
+TEST(ParserTest, FromNdjson) {
+  std::string input;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    input += "{\"id\":" + std::to_string(i) + ",\"values\":[";
+    for (std::size_t j = 0; j < i % 10; ++j) {
+      input += std::to_string(j) + ",";
+    }
+    input += "\"x\"]}";
+    // mix of line endings and blank lines
+    input += (i % 7 == 0) ? "\r\n" : ((i % 11 == 0) ? "\n  \n" : "\n");
+  }
+
+  for (std::size_t concurrency : {1, 2, 4, 0}) {
+    std::vector<SharedSlice> result =
+        Parser::fromNdjson(input, &Options::Defaults, concurrency);
+    ASSERT_EQ(1000UL, result.size());
+    for (std::size_t i = 0; i < result.size(); ++i) {
+      Slice s = result[i].slice();
+      ASSERT_EQ(i, s.get("id").getUInt());
+      ASSERT_EQ(i % 10 + 1, s.get("values").length());
+    }
+  }
+}
+
+TEST(ParserTest, FromNdjsonEmpty) {
+  ASSERT_TRUE(Parser::fromNdjson("").empty());
+  ASSERT_TRUE(Parser::fromNdjson("\n \n\r\n").empty());
+
+  std::vector<SharedSlice> result = Parser::fromNdjson("1\n\"a\"");
+  ASSERT_EQ(2UL, result.size());
+  ASSERT_EQ(1UL, result[0].slice().getUInt());
+  ASSERT_EQ("a", result[1].slice().copyString());
+}
+
+TEST(ParserTest, FromNdjsonFirstErrorIsReported) {
+  std::string input;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    if (i == 500) {
+      input += "[1,2,3\n";
+    } else if (i == 700) {
+      input += "\"\xff\"\n";
+    } else {
+      input += "{}\n";
+    }
+  }
+
+  Options options;
+  options.validateUtf8Strings = true;
+  for (std::size_t concurrency : {1, 4}) {
+    ASSERT_VELOCYPACK_EXCEPTION(Parser::fromNdjson(input, &options, concurrency),
+                                Exception::ParseError);
+  }
+}
+
+static void checkParallelArray(std::string const& value,
+                               Options options = Options()) {
+  std::shared_ptr<Builder> expected = Parser::fromJson(value, &options);
+  for (uint32_t threads : {2, 4, 0}) {
+    options.parallelArrayThreads = threads;
+    std::shared_ptr<Builder> actual = Parser::fromJson(value, &options);
+    ASSERT_EQ(expected->size(), actual->size());
+    ASSERT_EQ(0, memcmp(expected->data(), actual->data(), actual->size()));
+  }
+}
+
+TEST(ParserTest, ParallelArray) {
+  std::string value("[");
+  for (std::size_t i = 0; value.size() < 3 * 1024 * 1024; ++i) {
+    if (i > 0) {
+      value += ",\n";
+    }
+    switch (i % 5) {
+      case 0:
+        value += std::to_string(i * 7919);
+        break;
+      case 1:
+        value += "\"str,ing]\\\"" + std::to_string(i) + "\"";
+        break;
+      case 2:
+        value += "{\"a\":[1,2,{\"b\":\"}\"}],\"c\":" + std::to_string(i) + "}";
+        break;
+      case 3:
+        value += "[[],{},null,true,-1.5e3]";
+        break;
+      default:
+        value += "{}";
+        break;
+    }
+  }
+  value += " ] \n";
+
+  checkParallelArray(value);
+
+  Options options;
+  options.buildUnindexedArrays = true;
+  options.buildUnindexedObjects = true;
+  checkParallelArray(value, options);
+}
+
+TEST(ParserTest, ParallelArraySameSizeMembers) {
+  std::string value("[");
+  for (std::size_t i = 0; i < 400000; ++i) {
+    value += (i > 0) ? ",\"abc\"" : "\"abc\"";
+  }
+  value += "]";
+
+  checkParallelArray(value);
+}
+
+TEST(ParserTest, ParallelArrayErrors) {
+  std::string members;
+  for (std::size_t i = 0; i < 200000; ++i) {
+    members += "[";
+    members += std::to_string(i);
+    members += ",\"x\"],";
+  }
+
+  Options options;
+  options.parallelArrayThreads = 4;
+  for (std::string const& value :
+       {"[" + members + "1,]", "[" + members + "1 2]", "[" + members,
+        "[" + members + "{\"a\"]}, 1]", "[" + members + "1] x",
+        "[" + members + "[1}]"}) {
+    Parser parser(&options);
+    ASSERT_VELOCYPACK_EXCEPTION(parser.parse(value), Exception::ParseError);
+    Parser expected;
+    ASSERT_VELOCYPACK_EXCEPTION(expected.parse(value), Exception::ParseError);
+  }
+}
+
+TEST(ParserTest, ParallelArrayNestingLimit) {
+  std::string value("[");
+  for (std::size_t i = 0; i < 200000; ++i) {
+    value += "[[1]],";
+  }
+  value += "[[[1]]]]";
+
+  Options options;
+  options.nestingLimit = 4;
+  ASSERT_VELOCYPACK_EXCEPTION(Parser::fromJson(value, &options),
+                              Exception::TooDeepNesting);
+  options.parallelArrayThreads = 4;
+  ASSERT_VELOCYPACK_EXCEPTION(Parser::fromJson(value, &options),
+                              Exception::TooDeepNesting);
+  options.nestingLimit = 5;
+  checkParallelArray(value, options);
+}
+
+TEST(ParserTest, ParallelArrayStructuralIndex) {
+  std::string members;
+  for (std::size_t i = 0; i < 200000; ++i) {
+    members += "{\"a\":";
+    members += std::to_string(i);
+    members += "},";
+  }
+
+  Options options;
+  options.useStructuralIndex = true;
+  checkParallelArray("[" + members + "1]", options);
+
+  // other top-level values still use the structural index
+  std::string const value("{\"a\":[" + members + "1]}");
+  options.parallelArrayThreads = 4;
+  std::shared_ptr<Builder> actual = Parser::fromJson(value, &options);
+  std::shared_ptr<Builder> expected = Parser::fromJson(value);
+  ASSERT_EQ(expected->size(), actual->size());
+  ASSERT_EQ(0, memcmp(expected->data(), actual->data(), actual->size()));
+
+  ASSERT_VELOCYPACK_EXCEPTION(
+      Parser::fromJson("[" + members + "1] x", &options),
+      Exception::ParseError);
+}
+
+TEST(ParserTest, ParallelArrayBuilderOptions) {
+  std::string value("[");
+  for (std::size_t i = 0; i < 200000; ++i) {
+    value += "{\"a\":";
+    value += std::to_string(i);
+    value += ",\"b\":\"x\"},";
+  }
+  value += "1]";
+
+  // the members are built with the options of the Builder, not with the
+  // options of the Parser
+  Options builderOptions;
+  builderOptions.buildUnindexedObjects = true;
+  Builder expected(&builderOptions);
+  Parser serial(expected);
+  serial.parse(value);
+
+  Options parserOptions;
+  parserOptions.parallelArrayThreads = 4;
+  Builder actual(&builderOptions);
+  Parser parallel(actual, &parserOptions);
+  parallel.parse(value);
+
+  ASSERT_EQ(0x14, actual.slice().at(0).head());
+  ASSERT_EQ(expected.size(), actual.size());
+  ASSERT_EQ(0, memcmp(expected.data(), actual.data(), actual.size()));
+}
+
+TEST(ParserTest, Projection) {
+  std::string const value(
+      "{\"a\":1,\"b\":{\"c\":\"x\",\"d\":[1,2,{\"e\":3}]},"
+      "\"f\":\"skip \\\"me\\\" {[\\\\\",\"g\":{\"h\":[{\"i\":1,\"j\":2},5,"
+      "{\"j\":[3]},[{\"j\":4}]]},\"k\":null,\"l\":{\"m\":[{}]}}");
+
+  AttributeProjection projection;
+  projection.add({"a"});
+  projection.add({"b", "c"});
+  projection.add({"g", "h", "j"});
+  projection.add({"k", "x"});
+  projection.add({"l", "m", "n"});
+  projection.add({"z"});
+
+  Options options;
+  options.projection = &projection;
+  std::shared_ptr<Builder> b = Parser::fromJson(value, &options);
+  ASSERT_EQ(
+      "{\"a\":1,\"b\":{\"c\":\"x\"},\"g\":{\"h\":[{\"j\":2},{\"j\":[3]},[{\"j\":"
+      "4}]]},\"l\":{\"m\":[{}]}}",
+      b->slice().toJson());
+
+  // selecting a prefix of a path selects the whole value
+  projection.add({"b"});
+  b = Parser::fromJson(value, &options);
+  ASSERT_EQ("{\"c\":\"x\",\"d\":[1,2,{\"e\":3}]}",
+            b->slice().get("b").toJson());
+
+  // an empty path selects everything
+  projection.add({});
+  b = Parser::fromJson(value, &options);
+  ASSERT_EQ(Parser::fromJson(value)->slice().toJson(), b->slice().toJson());
+}
+
+TEST(ParserTest, ProjectionTopLevel) {
+  AttributeProjection projection;
+  projection.add({"a"});
+
+  Options options;
+  options.projection = &projection;
+  ASSERT_EQ("[{\"a\":1},{},{\"a\":[2]}]",
+            Parser::fromJson(" [{\"a\":1,\"b\":2}, {\"b\":3}, 4, {\"a\":[2]}] ",
+                             &options)
+                ->slice()
+                .toJson());
+  ASSERT_EQ("\"foo\"", Parser::fromJson("\"foo\"", &options)->slice().toJson());
+  ASSERT_EQ("-1.5", Parser::fromJson("-1.5", &options)->slice().toJson());
+  ASSERT_EQ("{}", Parser::fromJson("{}", &options)->slice().toJson());
+
+  // attribute names with escape sequences
+  projection.clear();
+  projection.add({"ab"});
+  projection.add({"\"c"});
+  ASSERT_EQ("{\"\\\"c\":3,\"ab\":1}",
+            Parser::fromJson("{\"a\\u0062\":1,\"b\":2,\"\\\"c\":3,\"\\\"d\":4}",
+                             &options)
+                ->slice()
+                .toJson());
+
+  Builder builder;
+  options.keepTopLevelOpen = true;
+  Parser parser(builder, &options);
+  parser.parse("{\"ab\":1,\"x\":2}");
+  ASSERT_TRUE(builder.isOpenObject());
+  builder.close();
+  ASSERT_EQ("{\"ab\":1}", builder.slice().toJson());
+}
+
+TEST(ParserTest, ProjectionWithTranslator) {
+  std::unique_ptr<AttributeTranslator> translator(new AttributeTranslator);
+  translator->add("a", 1);
+  translator->seal();
+  AttributeTranslatorScope scope(translator.get());
+
+  AttributeProjection projection;
+  projection.add({"a"});
+  projection.add({"b"});
+
+  Options options;
+  options.attributeTranslator = translator.get();
+  options.projection = &projection;
+  std::shared_ptr<Builder> b =
+      Parser::fromJson("{\"a\":1,\"b\":2,\"c\":3}", &options);
+  Slice s = b->slice();
+  ASSERT_EQ(2UL, s.length());
+  ASSERT_TRUE(s.keyAt(0, false).isSmallInt());
+  ASSERT_EQ(1UL, s.get("a").getUInt());
+  ASSERT_EQ(2UL, s.get("b").getUInt());
+}
+
+TEST(ParserTest, ProjectionErrors) {
+  AttributeProjection projection;
+  projection.add({"a"});
+
+  Options options;
+  options.projection = &projection;
+  for (char const* value :
+       {"{\"x\":\"abc}", "{\"x\":[1,2", "{\"x\":}", "{\"x\":1 \"y\":2}",
+        "{\"x\":1,}", "{\"a\":tru}", "{\"a\":1", "{\"x\" 1}", "{\"x\":{}} x",
+        "[{\"x\":[]},]", "{\"a\\u00\":1}", "{\"x\":\"\\\\\\\"}"}) {
+    ASSERT_VELOCYPACK_EXCEPTION(Parser::fromJson(value, &options),
+                                Exception::ParseError);
+  }
+}
+
+static void checkPredictedKeys(std::vector<std::string> const& members,
+                               Options const* options = &Options::Defaults) {
+  std::string value("[");
+  for (auto const& member : members) {
+    if (value.size() > 1) {
+      value += " , ";
+    }
+    value += member;
+  }
+  value += "]";
+
+  Parser parser(options);
+  // parse twice, to also predict from a previous parse
+  for (int run = 0; run < 2; ++run) {
+    parser.parse(value);
+    Slice s = parser.builder().slice();
+    ASSERT_EQ(members.size(), s.length());
+    for (std::size_t i = 0; i < members.size(); ++i) {
+      std::shared_ptr<Builder> expected = Parser::fromJson(members[i], options);
+      Slice member = s.at(i);
+      ASSERT_EQ(expected->size(), member.byteSize());
+      ASSERT_EQ(0, memcmp(expected->data(), member.start(), member.byteSize()));
+    }
+  }
+}
+
+TEST(ParserTest, PredictedKeys) {
+  checkPredictedKeys({"{\"a\":1,\"b\":2}", "{\"a\":3,\"b\":4}",
+                      "{ \"a\" : 5 , \"b\" : 6 }", "{\"b\":7,\"a\":8}",
+                      "{\"a\":9}", "{\"a\":10,\"b\":11,\"c\":12}",
+                      "{\"ab\":13,\"b\":14}", "{\"a\":15,\"bb\":16}", "{}",
+                      "{\"a\":17,\"b\":18}", "1", "[{\"a\":1},{\"a\":2}]",
+                      "{\"a\":{\"a\":[{\"a\":1},{\"b\":2}]},\"b\":[]}"});
+
+  // attribute names with escape sequences and long names
+  std::string const longName(200, 'x');
+  checkPredictedKeys({"{\"a\\\"b\":1,\"\\u0063\":2}",
+                      "{\"a\\\"b\":3,\"\\u0063\":4}", "{\"a\\\"\":5,\"c\":6}",
+                      "{\"" + longName + "\":1}", "{\"" + longName + "\":2}",
+                      "{\"" + longName + "y\":3}", "{\"a\":{\"b\":1}}",
+                      "{\"a\":{\"b\":2}}"});
+
+  // a predicted name must be followed by the rest of the object
+  ASSERT_VELOCYPACK_EXCEPTION(Parser::fromJson("[{\"abc\":1},{\"abc\""),
+                              Exception::ParseError);
+  ASSERT_VELOCYPACK_EXCEPTION(Parser::fromJson("[{\"abc\":1},{\"ab"),
+                              Exception::ParseError);
+}
+
+TEST(ParserTest, PredictedKeysWithTranslator) {
+  std::unique_ptr<AttributeTranslator> translator(new AttributeTranslator);
+  translator->add("a", 1);
+  translator->seal();
+  AttributeTranslatorScope scope(translator.get());
+
+  Options options;
+  options.attributeTranslator = translator.get();
+  checkPredictedKeys({"{\"a\":1,\"b\":2}", "{\"a\":3,\"b\":4}",
+                      "{\"b\":5,\"a\":6}", "{\"a\":7}"},
+                     &options);
+
+  // predictions must not survive changes of the options
+  Parser parser(&options);
+  parser.parse("[{\"a\":1}]");
+  ASSERT_TRUE(parser.builder().slice().at(0).keyAt(0, false).isSmallInt());
+  options.attributeTranslator = nullptr;
+  parser.parse("[{\"a\":1}]");
+  ASSERT_TRUE(parser.builder().slice().at(0).keyAt(0, false).isString());
+}
+
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
 
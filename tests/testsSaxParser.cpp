@@ -0,0 +1,201 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+/// @author Copyright 2015, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include "tests-common.h"
+
+namespace {
+
+// records all events as strings
+struct RecordingHandler {
+  void startObject() { events.emplace_back("{"); }
+  void endObject() { events.emplace_back("}"); }
+  void startArray() { events.emplace_back("["); }
+  void endArray() { events.emplace_back("]"); }
+  void key(std::string_view name) {
+    events.emplace_back("key:" + std::string(name));
+  }
+  void string(std::string_view value) {
+    events.emplace_back("string:" + std::string(value));
+  }
+  void number(uint64_t value) {
+    events.emplace_back("uint:" + std::to_string(value));
+  }
+  void number(int64_t value) {
+    events.emplace_back("int:" + std::to_string(value));
+  }
+  void number(double value) {
+    events.emplace_back("double:" + std::to_string(value));
+  }
+  void boolean(bool value) { events.emplace_back(value ? "true" : "false"); }
+  void null() { events.emplace_back("null"); }
+
+  std::vector<std::string> events;
+};
+
+// counts the values of all attributes with a certain name
+struct CountingHandler {
+  void startObject() {}
+  void endObject() {}
+  void startArray() {}
+  void endArray() {}
+  void key(std::string_view name) { inKey = (name == "n"); }
+  void string(std::string_view) { inKey = false; }
+  void number(uint64_t value) {
+    if (inKey) {
+      sum += value;
+    }
+    inKey = false;
+  }
+  void number(int64_t) { inKey = false; }
+  void number(double) { inKey = false; }
+  void boolean(bool) { inKey = false; }
+  void null() { inKey = false; }
+
+  uint64_t sum = 0;
+  bool inKey = false;
+};
+
+void checkSameAsParser(std::string const& value,
+                       Options const* options = &Options::Defaults) {
+  std::shared_ptr<Builder> expected = Parser::fromJson(value, options);
+
+  Builder actual(options);
+  BuilderSaxHandler handler(actual);
+  SaxParser<BuilderSaxHandler> parser(handler, options);
+  parser.parse(value);
+
+  ASSERT_EQ(expected->size(), actual.size());
+  ASSERT_EQ(0, memcmp(expected->data(), actual.data(), actual.size()));
+}
+
+}  // namespace
+
+TEST(SaxParserTest, Events) {
+  RecordingHandler handler;
+  SaxParser<RecordingHandler> parser(handler);
+  parser.parse(
+      " {\"a\":[1,-2,2.5,\"x\\ty\",true,false,null,{}],\"b\\u0063\":{\"d\":[]},"
+      "\"e\":18446744073709551615} ");
+
+  std::vector<std::string> const expected{
+      "{",      "key:a",  "[",           "uint:1",          "int:-2",
+      "double:2.500000", "string:x\ty", "true", "false", "null",
+      "{",      "}",      "]",           "key:bc",          "{",
+      "key:d",  "[",      "]",           "}",               "key:e",
+      "uint:18446744073709551615",       "}"};
+  ASSERT_EQ(expected, handler.events);
+}
+
+TEST(SaxParserTest, Scalars) {
+  RecordingHandler handler;
+  SaxParser<RecordingHandler> parser(handler);
+  for (char const* value :
+       {"null", "true", "false", "0", "-0", "\"\"", "\"foo\"", "1e3", "-7"}) {
+    parser.parse(value);
+  }
+  std::vector<std::string> const expected{
+      "null",    "true",       "false",              "uint:0", "uint:0",
+      "string:", "string:foo", "double:1000.000000", "int:-7"};
+  ASSERT_EQ(expected, handler.events);
+}
+
+TEST(SaxParserTest, SameAsParser) {
+  checkSameAsParser("[]");
+  checkSameAsParser("{}");
+  checkSameAsParser(" [ 1 , 2.5 , \"three\" , [ ] , { } , true , null ] ");
+  checkSameAsParser(
+      "{\"a\":1,\"b\":[1,2,{\"c\":\"d\"}],\"e\":{\"f\":{}},\"g\":-0}");
+  checkSameAsParser("[-12345678901234567890,18446744073709551615,-1.25e-7]");
+  checkSameAsParser("\"\\u00e4\\ud83d\\ude00 \xc3\xa4" + std::string(300, 'x') +
+                    "\"");
+
+  std::string value("[");
+  for (std::size_t i = 0; i < 1000; ++i) {
+    value += "{\"n\":" + std::to_string(i) + ",\"s\":\"" + std::to_string(i) +
+             "\"},";
+  }
+  value += "null]";
+  checkSameAsParser(value);
+
+  Options options;
+  options.buildUnindexedArrays = true;
+  options.buildUnindexedObjects = true;
+  checkSameAsParser(value, &options);
+}
+
+TEST(SaxParserTest, Counting) {
+  std::string value("[");
+  for (std::size_t i = 0; i < 100; ++i) {
+    value += "{\"n\":" + std::to_string(i) + ",\"m\":{\"n\":1}},";
+  }
+  value += "{\"n\":\"foo\"}]";
+
+  CountingHandler handler;
+  SaxParser<CountingHandler> parser(handler);
+  parser.parse(value);
+  ASSERT_EQ(4950UL + 100UL, handler.sum);
+}
+
+TEST(SaxParserTest, Errors) {
+  RecordingHandler handler;
+  SaxParser<RecordingHandler> parser(handler);
+  for (char const* value :
+       {"", " ", "[", "[1,]", "{\"a\"}", "{\"a\":1,}", "{1:2}", "tru", "nul",
+        "-", "1.", "\"abc", "[1] x", "{\"a\":1}}", "[1 2]"}) {
+    ASSERT_VELOCYPACK_EXCEPTION(parser.parse(value), Exception::ParseError);
+  }
+
+  ASSERT_VELOCYPACK_EXCEPTION(parser.parse("\"a\nb\""),
+                              Exception::UnexpectedControlCharacter);
+
+  try {
+    parser.parse("[1,2,x]");
+    ASSERT_TRUE(false);
+  } catch (Exception const&) {
+    ASSERT_EQ(5U, parser.errorPos());
+  }
+
+  Options options;
+  options.nestingLimit = 3;
+  SaxParser<RecordingHandler> limited(handler, &options);
+  limited.parse("[[1]]");
+  ASSERT_VELOCYPACK_EXCEPTION(Parser::fromJson("[{\"a\":[]}]", &options),
+                              Exception::TooDeepNesting);
+  ASSERT_VELOCYPACK_EXCEPTION(limited.parse("[{\"a\":[]}]"),
+                              Exception::TooDeepNesting);
+
+  options.validateUtf8Strings = true;
+  ASSERT_VELOCYPACK_EXCEPTION(limited.parse("\"\xff\""),
+                              Exception::InvalidUtf8Sequence);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
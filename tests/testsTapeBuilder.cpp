@@ -0,0 +1,442 @@
+////////////////////////////////////////////////////////////////////////////////
+/// DISCLAIMER
+///
+/// Copyright 2014-2024 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Business Source License 1.1 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     https://github.com/arangodb/arangodb/blob/devel/LICENSE
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Max Neunhoeffer
+/// @author Jan Steemann
+////////////////////////////////////////////////////////////////////////////////
+
+
+#include <string>
+
+#include "tests-common.h"
+
+namespace {
+
+// builds the same values with a Builder and a TapeBuilder, and checks
+// that both produce identical VPack
+template<typename F>
+void checkSameAsBuilder(F&& build, Options const* options) {
+  Builder expected(options);
+  build(expected);
+
+  TapeBuilder tape(options);
+  build(tape);
+  ASSERT_TRUE(tape.isClosed());
+  ASSERT_EQ(expected.size(), tape.size());
+
+  Builder actual(options);
+  tape.writeTo(actual);
+  ASSERT_EQ(expected.size(), actual.size());
+  ASSERT_EQ(0, memcmp(expected.data(), actual.data(), actual.size()));
+
+  Validator validator(options);
+  ASSERT_TRUE(validator.validate(actual.data(), actual.size()));
+}
+
+template<typename F>
+void checkSameAsBuilder(F&& build) {
+  Options options;
+  options.paddingBehavior = Options::PaddingBehavior::NoPadding;
+  checkSameAsBuilder(build, &options);
+}
+
+// builds the same value with a Builder and a TapeBuilder, and checks that
+// both are equal and that the TapeBuilder's VPack is not larger. the
+// Builder leaves padding behind the headers of large Arrays and Objects
+template<typename F>
+void checkEquivalentToBuilder(F&& build) {
+  Options options;
+  options.paddingBehavior = Options::PaddingBehavior::NoPadding;
+
+  Builder expected(&options);
+  build(expected);
+
+  TapeBuilder tape(&options);
+  build(tape);
+  Builder actual(&options);
+  tape.writeTo(actual);
+  ASSERT_EQ(tape.size(), actual.size());
+  ASSERT_LE(actual.size(), expected.size());
+
+  Validator validator(&options);
+  ASSERT_TRUE(validator.validate(actual.data(), actual.size()));
+  ASSERT_EQ(expected.slice().toJson(), actual.slice().toJson());
+}
+
+}  // namespace
+
+TEST(TapeBuilderTest, Empty) {
+  TapeBuilder tape;
+  ASSERT_TRUE(tape.isEmpty());
+  ASSERT_TRUE(tape.isClosed());
+  ASSERT_EQ(0UL, tape.size());
+
+  Builder b;
+  tape.writeTo(b);
+  ASSERT_EQ(0UL, b.size());
+}
+
+TEST(TapeBuilderTest, Scalars) {
+  checkSameAsBuilder([](auto& b) { b.add(Value(ValueType::Null)); });
+  checkSameAsBuilder([](auto& b) { b.add(Value(true)); });
+  checkSameAsBuilder([](auto& b) { b.add(Value(-12345)); });
+  checkSameAsBuilder([](auto& b) { b.add(Value(1.5)); });
+  checkSameAsBuilder([](auto& b) { b.add(Value("foobar")); });
+  checkSameAsBuilder(
+      [](auto& b) { b.add(Value(std::string(300, 'x'))); });
+}
+
+TEST(TapeBuilderTest, EmptyCompounds) {
+  checkSameAsBuilder([](auto& b) {
+    b.openArray();
+    b.close();
+  });
+  checkSameAsBuilder([](auto& b) {
+    b.openObject();
+    b.close();
+  });
+  checkSameAsBuilder([](auto& b) {
+    b.openArray();
+    b.openObject();
+    b.close();
+    b.openArray();
+    b.close();
+    b.close();
+  });
+}
+
+TEST(TapeBuilderTest, Arrays) {
+  // equal member sizes, no index table
+  checkSameAsBuilder([](auto& b) {
+    b.openArray();
+    for (int i = 0; i < 10; ++i) {
+      b.add(Value(i));
+    }
+    b.close();
+  });
+  // different member sizes
+  checkSameAsBuilder([](auto& b) {
+    b.openArray();
+    b.add(Value(1));
+    b.add(Value("foo"));
+    b.add(Value(1.5));
+    b.add(Value(ValueType::Null));
+    b.close();
+  });
+  // single member
+  checkSameAsBuilder([](auto& b) {
+    b.openArray();
+    b.add(Value("foo"));
+    b.close();
+  });
+  // compact
+  checkSameAsBuilder([](auto& b) {
+    b.openArray(true);
+    b.add(Value(1));
+    b.add(Value("foo"));
+    b.close();
+  });
+}
+
+TEST(TapeBuilderTest, Objects) {
+  checkSameAsBuilder([](auto& b) {
+    b.openObject();
+    b.add("foo", Value(1));
+    b.close();
+  });
+  checkSameAsBuilder([](auto& b) {
+    b.openObject();
+    b.add("zeta", Value(1));
+    b.add("alpha", Value("foo"));
+    b.add("mu", Value(true));
+    b.add("beta", Value(ValueType::Null));
+    b.close();
+  });
+  checkSameAsBuilder([](auto& b) {
+    b.openObject(true);
+    b.add("b", Value(1));
+    b.add("a", Value(2));
+    b.close();
+  });
+  // attribute names and values added separately
+  checkSameAsBuilder([](auto& b) {
+    b.openObject();
+    b.add(Value("b"));
+    b.add(Value(1));
+    b.add(Value("a"));
+    b.add(Value(ValueType::Array));
+    b.close();
+    b.close();
+  });
+}
+
+TEST(TapeBuilderTest, UnindexedOptions) {
+  Options options;
+  options.paddingBehavior = Options::PaddingBehavior::NoPadding;
+  options.buildUnindexedArrays = true;
+  options.buildUnindexedObjects = true;
+  checkSameAsBuilder(
+      [](auto& b) {
+        b.openObject();
+        b.add("a", Value(ValueType::Array));
+        b.add(Value(1));
+        b.add(Value("two"));
+        b.close();
+        b.add("b", Value(ValueType::Object));
+        b.add("c", Value(3));
+        b.add("d", Value(4));
+        b.close();
+        b.close();
+      },
+      &options);
+}
+
+TEST(TapeBuilderTest, SelectCompactFormat) {
+  Options options;
+  options.paddingBehavior = Options::PaddingBehavior::NoPadding;
+  options.selectCompactFormat = true;
+  checkSameAsBuilder(
+      [](auto& b) {
+        b.openObject();
+        b.add("small", Value(ValueType::Array));
+        b.add(Value(1));
+        b.add(Value("two"));
+        b.close();
+        b.add("same", Value(ValueType::Array));
+        for (int i = 0; i < 20; ++i) {
+          b.add(Value(i % 10));
+        }
+        b.close();
+        b.add("large", Value(ValueType::Object));
+        for (int i = 0; i < 20; ++i) {
+          b.add(std::string("key") + std::to_string(i), Value(i));
+        }
+        b.close();
+        b.close();
+      },
+      &options);
+}
+
+TEST(TapeBuilderTest, LargeCompounds) {
+  // offset sizes of 1, 2 and 4 bytes, with and without index tables
+  for (std::size_t n : {10, 200, 5000, 70000}) {
+    checkEquivalentToBuilder([n](auto& b) {
+      b.openArray();
+      for (std::size_t i = 0; i < n; ++i) {
+        b.add(Value(i));
+      }
+      b.close();
+    });
+    checkEquivalentToBuilder([n](auto& b) {
+      b.openArray();
+      for (std::size_t i = 0; i < n; ++i) {
+        b.add(Value("x"));
+      }
+      b.close();
+    });
+    checkEquivalentToBuilder([n](auto& b) {
+      b.openObject();
+      for (std::size_t i = 0; i < n; ++i) {
+        b.add("key" + std::to_string(n - i), Value(i));
+      }
+      b.close();
+    });
+  }
+  checkSameAsBuilder([](auto& b) {
+    b.openArray(true);
+    for (std::size_t i = 0; i < 1000; ++i) {
+      b.add(Value(std::to_string(i)));
+    }
+    b.close();
+  });
+}
+
+TEST(TapeBuilderTest, DeepNesting) {
+  checkSameAsBuilder([](auto& b) {
+    for (int i = 0; i < 100; ++i) {
+      b.openArray();
+      b.add(Value(std::string(static_cast<std::size_t>(i) * 10, 'x')));
+      b.openObject();
+      b.add("value", Value(i));
+      b.add("name", Value("level"));
+      b.add("nested", Value(ValueType::Array));
+    }
+    for (int i = 0; i < 100; ++i) {
+      b.close();
+      b.close();
+      b.close();
+    }
+  });
+}
+
+TEST(TapeBuilderTest, FirstMemberStartsWithZeroByte) {
+  // the first member must not be confused with padding
+  checkSameAsBuilder([](auto& b) {
+    b.openArray();
+    b.add(Slice::noneSlice());
+    b.add(Value(12345));
+    b.close();
+  });
+
+  TapeBuilder tape;
+  tape.openArray();
+  tape.add(Slice::noneSlice());
+  tape.add(Value("foo"));
+  tape.close();
+  Builder b;
+  tape.writeTo(b);
+  ASSERT_EQ(2UL, b.slice().length());
+  ASSERT_TRUE(b.slice().at(0).isNone());
+  ASSERT_EQ("foo", b.slice().at(1).stringView());
+}
+
+TEST(TapeBuilderTest, Slices) {
+  Builder sub;
+  sub.openObject();
+  sub.add("a", Value(1));
+  sub.add("b", Value("foo"));
+  sub.close();
+
+  checkSameAsBuilder([&sub](auto& b) {
+    b.openObject();
+    b.add("sub", sub.slice());
+    b.add(Slice(sub.slice().get("b")));
+    b.add(sub.slice().get("a"));
+    b.close();
+  });
+}
+
+TEST(TapeBuilderTest, MultipleTopLevelValues) {
+  Builder expected;
+  expected.add(Value(1));
+  expected.openArray();
+  expected.add(Value(2));
+  expected.close();
+  expected.add(Value("three"));
+
+  TapeBuilder tape;
+  tape.add(Value(1));
+  tape.openArray();
+  tape.add(Value(2));
+  tape.close();
+  tape.add(Value("three"));
+
+  Builder actual;
+  actual.add(Value(ValueType::Null));
+  tape.writeTo(actual);
+  ASSERT_EQ(expected.size() + 1, actual.size());
+  ASSERT_EQ(0, memcmp(expected.data(), actual.data() + 1, expected.size()));
+}
+
+TEST(TapeBuilderTest, AttributeTranslator) {
+  std::unique_ptr<AttributeTranslator> translator(new AttributeTranslator);
+  translator->add("_key", 1);
+  translator->add("_id", 2);
+  translator->seal();
+
+  AttributeTranslatorScope scope(translator.get());
+
+  Options options;
+  options.paddingBehavior = Options::PaddingBehavior::NoPadding;
+  options.attributeTranslator = translator.get();
+  checkSameAsBuilder(
+      [](auto& b) {
+        b.openObject();
+        b.add("_id", Value("foo/bar"));
+        b.add("_key", Value("bar"));
+        b.add("a", Value(1));
+        b.close();
+      },
+      &options);
+
+  TapeBuilder tape(&options);
+  tape.openObject();
+  tape.add("_id", Value("foo/bar"));
+  tape.add("_key", Value("bar"));
+  tape.add("a", Value(1));
+  tape.close();
+  Builder b(&options);
+  tape.writeTo(b);
+  ASSERT_EQ("bar", b.slice().get("_key").stringView());
+  ASSERT_EQ("foo/bar", b.slice().get("_id").stringView());
+  ASSERT_EQ(1, b.slice().get("a").getInt());
+}
+
+TEST(TapeBuilderTest, DuplicateAttributes) {
+  Options options;
+  options.checkAttributeUniqueness = true;
+
+  TapeBuilder tape(&options);
+  tape.openObject();
+  tape.add("a", Value(1));
+  tape.add("b", Value(2));
+  tape.add("a", Value(3));
+  ASSERT_VELOCYPACK_EXCEPTION(tape.close(), Exception::DuplicateAttributeName);
+
+  tape.clear();
+  tape.openObject(true);
+  tape.add("a", Value(1));
+  tape.add("a", Value(2));
+  ASSERT_VELOCYPACK_EXCEPTION(tape.close(), Exception::DuplicateAttributeName);
+
+  tape.clear();
+  tape.openObject();
+  tape.add("a", Value(1));
+  tape.add("b", Value(2));
+  tape.close();
+  ASSERT_TRUE(tape.isClosed());
+}
+
+TEST(TapeBuilderTest, Errors) {
+  TapeBuilder tape;
+  ASSERT_VELOCYPACK_EXCEPTION(tape.close(), Exception::BuilderNeedOpenCompound);
+  ASSERT_VELOCYPACK_EXCEPTION(tape.add("a", Value(1)),
+                              Exception::BuilderNeedOpenObject);
+
+  tape.openArray();
+  ASSERT_VELOCYPACK_EXCEPTION(tape.add("a", Value(1)),
+                              Exception::BuilderNeedOpenObject);
+  ASSERT_VELOCYPACK_EXCEPTION(tape.size(), Exception::BuilderNotSealed);
+  Builder b;
+  ASSERT_VELOCYPACK_EXCEPTION(tape.writeTo(b), Exception::BuilderNotSealed);
+
+  tape.clear();
+  tape.openObject();
+  ASSERT_VELOCYPACK_EXCEPTION(tape.add(Value(1)),
+                              Exception::BuilderKeyMustBeString);
+  ASSERT_VELOCYPACK_EXCEPTION(tape.openArray(),
+                              Exception::BuilderKeyMustBeString);
+  tape.add(Value("a"));
+  ASSERT_VELOCYPACK_EXCEPTION(tape.add("b", Value(1)),
+                              Exception::BuilderKeyAlreadyWritten);
+  ASSERT_VELOCYPACK_EXCEPTION(tape.close(),
+                              Exception::BuilderKeyAlreadyWritten);
+
+  tape.clear();
+  tape.add(Value(1));
+  b.openArray();
+  ASSERT_VELOCYPACK_EXCEPTION(tape.writeTo(b), Exception::BuilderNotSealed);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
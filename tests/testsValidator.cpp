@@ -2576,6 +2576,124 @@ TEST(ValidatorTest, ObjectCompactManyEntries) {
   ASSERT_TRUE(validator.validate(b.slice().start(), b.slice().byteSize()));
 }
 
+TEST(ValidatorTest, ObjectCompactDuplicateAttributes) {
+  std::string const value("\x14\x09\x41\x41\x18\x41\x41\x18\x02", 9);
+
+  Validator validator;
+  ASSERT_TRUE(validator.validate(value.c_str(), value.size()));
+
+  Options options;
+  options.checkAttributeUniqueness = true;
+  Validator checker(&options);
+  ASSERT_VELOCYPACK_EXCEPTION(checker.validate(value.c_str(), value.size()),
+                              Exception::DuplicateAttributeName);
+}
+
+TEST(ValidatorTest, ObjectCompactManyEntriesDuplicate) {
+  Builder b;
+  b.openObject(true);
+  for (std::size_t i = 0; i < 2048; ++i) {
+    b.add("test" + std::to_string(i), Value(i));
+  }
+  b.add("test1234", Value(true));
+  b.close();
+
+  Options options;
+  options.checkAttributeUniqueness = true;
+  Validator validator(&options);
+  ASSERT_VELOCYPACK_EXCEPTION(
+      validator.validate(b.slice().start(), b.slice().byteSize()),
+      Exception::DuplicateAttributeName);
+}
+
+TEST(ValidatorTest, ObjectIndexedManyEntriesUnique) {
+  Builder b;
+  b.openObject();
+  for (std::size_t i = 0; i < 2048; ++i) {
+    b.add("test" + std::to_string(i), Value(i));
+    // nested objects use the same scratch memory for their checks
+    b.add("nested" + std::to_string(i), Value(ValueType::Object, i % 2 == 0));
+    b.add("a", Value(1));
+    b.add("b", Value(2));
+    b.close();
+  }
+  b.close();
+
+  Options options;
+  options.checkAttributeUniqueness = true;
+  Validator validator(&options);
+  ASSERT_TRUE(validator.validate(b.slice().start(), b.slice().byteSize()));
+}
+
+TEST(ValidatorTest, ObjectIndexedDuplicateAttributes) {
+  for (std::size_t n : {2, 10, 200, 5000}) {
+    Builder b;
+    b.openObject();
+    for (std::size_t i = 0; i < n; ++i) {
+      b.add("test" + std::to_string(i), Value(i));
+    }
+    b.add("test0", Value(true));
+    b.close();
+
+    Validator validator;
+    ASSERT_TRUE(validator.validate(b.slice().start(), b.slice().byteSize()));
+
+    Options options;
+    options.checkAttributeUniqueness = true;
+    Validator checker(&options);
+    ASSERT_VELOCYPACK_EXCEPTION(
+        checker.validate(b.slice().start(), b.slice().byteSize()),
+        Exception::DuplicateAttributeName);
+  }
+}
+
+TEST(ValidatorTest, ObjectIndexedIntegerAttributes) {
+  Options options;
+  options.checkAttributeUniqueness = true;
+  Validator validator(&options);
+
+  std::string const unique("\x0b\x09\x02\x31\x18\x32\x18\x03\x05", 9);
+  ASSERT_TRUE(validator.validate(unique.c_str(), unique.size()));
+
+  // SmallInt 1 and the string "1" are different attribute names
+  std::string const mixed("\x0b\x0a\x02\x31\x18\x41\x31\x18\x03\x05", 10);
+  ASSERT_TRUE(validator.validate(mixed.c_str(), mixed.size()));
+
+  std::string const duplicate("\x0b\x09\x02\x31\x18\x31\x18\x03\x05", 9);
+  ASSERT_VELOCYPACK_EXCEPTION(
+      validator.validate(duplicate.c_str(), duplicate.size()),
+      Exception::DuplicateAttributeName);
+}
+
+TEST(ValidatorTest, ObjectIntegerAttributesDifferentEncodings) {
+  Options options;
+  options.checkAttributeUniqueness = true;
+  Validator validator(&options);
+
+  // SmallInt 1 and UInt 1 are the same attribute name
+  std::string const indexed("\x0b\x0a\x02\x31\x18\x28\x01\x18\x03\x05",
+                            10);
+  ASSERT_VELOCYPACK_EXCEPTION(
+      validator.validate(indexed.c_str(), indexed.size()),
+      Exception::DuplicateAttributeName);
+
+  std::string const compact("\x14\x08\x31\x18\x28\x01\x18\x02", 8);
+  ASSERT_VELOCYPACK_EXCEPTION(
+      validator.validate(compact.c_str(), compact.size()),
+      Exception::DuplicateAttributeName);
+
+  std::string const unique("\x14\x08\x31\x18\x28\x02\x18\x02", 8);
+  ASSERT_TRUE(validator.validate(unique.c_str(), unique.size()));
+}
+
+TEST(ValidatorTest, ObjectIndexDuplicateOffsets) {
+  std::string const value("\x0b\x0b\x02\x41\x61\x18\x41\x62\x18\x03\x03", 11);
+
+  Validator validator;
+  ASSERT_VELOCYPACK_EXCEPTION(validator.validate(value.c_str(), value.size()),
+                              Exception::ValidatorInvalidLength);
+}
+
 TEST(ValidatorTest, ObjectNegativeKeySmallInt) {
   std::string const value("\x0b\x06\x01\x3a\x18\x03", 6);
 
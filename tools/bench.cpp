@@ -41,7 +41,7 @@
 
 using namespace arangodb::velocypack;
 
-enum ParserType { UNKNOWN, VPACK, RAPIDJSON, SIMDJSON };
+enum ParserType { UNKNOWN, VPACK, VPACK_INDEXED, RAPIDJSON, SIMDJSON };
 
 static void usage(char* argv[]) {
   std::cout << "Usage: " << argv[0]
@@ -55,7 +55,7 @@ static void usage(char* argv[]) {
   std::cout << "out of cache. The target areas are also in a different memory"
             << std::endl;
   std::cout << "area for each copy." << std::endl;
-  std::cout << "TYPE must be: vpack/rapidjson/simdjson." << std::endl;
+  std::cout << "TYPE must be: vpack/vpack-indexed/rapidjson/simdjson." << std::endl;
 }
 
 static std::string tryReadFile(std::string const& filename) {
@@ -186,6 +186,8 @@ static ParserType parserTypeFromName(std::string_view name) noexcept {
   ParserType parserType = ParserType::VPACK;  // default
   if (name == "vpack") {
     parserType = ParserType::VPACK;
+  } else if (name == "vpack-indexed") {
+    parserType = ParserType::VPACK_INDEXED;
   } else if (name == "rapidjson") {
     parserType = ParserType::RAPIDJSON;
   } else if (name == "simdjson") {
@@ -200,6 +202,8 @@ static char const* parserTypeName(ParserType parserType) noexcept {
   switch (parserType) {
     case ParserType::VPACK:
       return "vpack";
+    case ParserType::VPACK_INDEXED:
+      return "vpack-indexed";
     case ParserType::RAPIDJSON:
       return "rapidjson";
     case ParserType::SIMDJSON:
@@ -212,6 +216,7 @@ static char const* parserTypeName(ParserType parserType) noexcept {
 static void run(std::string& data, int runTime, size_t copies,
                 ParserType parserType, bool fullOutput) {
   Options options;
+  options.useStructuralIndex = (parserType == ParserType::VPACK_INDEXED);
 
   std::vector<std::string> inputs;
   std::vector<std::unique_ptr<Parser>> outputs;
@@ -242,7 +247,8 @@ static void run(std::string& data, int runTime, size_t copies,
     do {
       for (int i = 0; i < 2; i++) {
         switch (parserType) {
-          case VPACK: {
+          case VPACK:
+          case VPACK_INDEXED: {
             outputs[count]->clear();
             outputs[count]->parse(inputs[count]);
             break;
@@ -331,6 +337,10 @@ static void runDefaultBench(bool all) {
               << "vpack        ";
     run(data, runSeconds, 1, ParserType::VPACK, fullOutput);
 
+    std::cout << "|" << filename << " | "
+              << "vpack-indexed";
+    run(data, runSeconds, 1, ParserType::VPACK_INDEXED, fullOutput);
+
     std::cout << "|" << filename << " | "
               << "rapidjson    ";
     run(data, runSeconds, 1, ParserType::RAPIDJSON, fullOutput);
@@ -343,14 +353,15 @@ static void runDefaultBench(bool all) {
   std::vector<std::string> files = {
       // default
       "small.json", "sample.json", "sampleNoWhite.json", "commits.json",
+      "doubles.json",
 
       // all datasets
       "api-docs.json", "countries.json", "directory-tree.json",
-      "doubles-small.json", "doubles.json", "file-list.json", "object.json",
+      "doubles-small.json", "file-list.json", "object.json",
       "pass1.json", "pass2.json", "pass3.json", "random1.json", "random2.json",
       "random3.json"};
 
-  int dataSetSize = all ? files.size() : 4;
+  int dataSetSize = all ? files.size() : 5;
   for (int i = 0; i < dataSetSize; i++) {
     runComparison(files[i]);
   }